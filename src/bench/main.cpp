@@ -0,0 +1,464 @@
+/**
+ * @file main.cpp
+ * @brief Throughput and end-to-end latency benchmark
+ *
+ * Streams MockDevice -> StreamThread -> LSLOutlet and consumes the stream
+ * with an in-process lsl::stream_inlet over loopback, sweeping channel
+ * count x sample rate x chunk size. Reports samples/s, process CPU and
+ * device-to-inlet latency percentiles, optionally as JSON so results can
+ * be tracked across liblsl and template versions.
+ *
+ * With --startup it instead times outlet creation for large channel
+ * layouts: building the stream description element by element and as one
+ * XML document, and constructing the complete LSLOutlet.
+ */
+
+#include <lsltemplate/Device.hpp>
+#include <lsltemplate/LSLOutlet.hpp>
+#include <lsltemplate/StreamThread.hpp>
+
+#include <lsl_cpp.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <ctime>
+#include <unistd.h>
+#endif
+
+#ifndef LSLTEMPLATE_VERSION
+#define LSLTEMPLATE_VERSION "unknown"
+#endif
+
+namespace {
+
+struct Options {
+    std::vector<int> channels{1, 8, 64};
+    std::vector<double> rates{100.0, 1000.0, 10000.0};
+    std::vector<double> chunk_ms{1.0, 10.0, 100.0};
+    double duration = 3.0;  // Measured seconds per case
+    bool decoupled = false;
+    std::string json_path;  // Empty: table only; "-": JSON to stdout
+
+    // Outlet creation benchmark instead of streaming
+    bool startup = false;
+    std::vector<int> startup_channels{1024, 4096, 16384};
+    int startup_repeats = 5;  // Median of this many runs per measurement
+};
+
+struct Result {
+    int channels = 0;
+    double sample_rate = 0.0;
+    double chunk_ms = 0.0;
+    std::size_t chunk_samples = 0;
+    double duration = 0.0;
+    uint64_t samples = 0;        // Received by the inlet
+    double samples_per_second = 0.0;
+    double cpu_percent = 0.0;    // Whole process: outlet and inlet side, liblsl threads included
+    double p50_ms = 0.0;
+    double p99_ms = 0.0;
+    double p999_ms = 0.0;
+    double max_ms = 0.0;
+};
+
+struct StartupResult {
+    int channels = 0;
+    double element_ms = 0.0;  // makeStreamInfo() through the element API
+    double bulk_ms = 0.0;     // makeStreamInfo() through one XML document
+    double outlet_ms = 0.0;   // LSLOutlet construction (default path)
+    std::size_t xml_bytes = 0;
+};
+
+/**
+ * MockDevice that stamps each chunk with lsl::local_clock() when it is
+ * read, so inlet timestamps measure latency from the device read onwards
+ */
+class StampingDevice : public lsltemplate::MockDevice {
+public:
+    using MockDevice::MockDevice;
+    using MockDevice::getData;
+
+    std::size_t getData(std::span<float> out, double& timestamp) override {
+        const std::size_t samples = MockDevice::getData(out, timestamp);
+        if (samples != kReadError && samples != kEndOfData && samples > 0) {
+            timestamp = lsl::local_clock();
+        }
+        return samples;
+    }
+};
+
+#ifdef _WIN32
+double fileTimeSeconds(const FILETIME& t) {
+    return (static_cast<double>(t.dwHighDateTime) * 4294967296.0 + t.dwLowDateTime) * 1e-7;
+}
+#endif
+
+double processCpuSeconds() {
+#ifdef _WIN32
+    FILETIME creation, exit, kernel, user;
+    GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user);
+    return fileTimeSeconds(kernel) + fileTimeSeconds(user);
+#else
+    timespec ts{};
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) * 1e-9;
+#endif
+}
+
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    const auto index = static_cast<std::size_t>(std::ceil(p * static_cast<double>(sorted.size()))) - 1;
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+template <typename T>
+std::vector<T> parseList(const std::string& text) {
+    std::vector<T> values;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        std::size_t used = 0;
+        values.push_back(static_cast<T>(std::stod(item, &used)));
+        if (used != item.size()) {
+            throw std::invalid_argument(item);
+        }
+    }
+    if (values.empty()) {
+        throw std::invalid_argument(text);
+    }
+    return values;
+}
+
+Result runCase(const Options& options, int channels, double rate, double chunk_ms, int index) {
+    Result result;
+    result.channels = channels;
+    result.sample_rate = rate;
+    result.chunk_ms = chunk_ms;
+    result.chunk_samples = std::max<std::size_t>(1, static_cast<std::size_t>(rate * chunk_ms / 1000.0));
+
+    // Unique per process and case so concurrent runs cannot cross-connect
+#ifdef _WIN32
+    const auto pid = GetCurrentProcessId();
+#else
+    const auto pid = getpid();
+#endif
+    const std::string name = "lsltemplate_bench_" + std::to_string(pid) + "_" + std::to_string(index);
+
+    lsltemplate::MockDevice::Config device_config;
+    device_config.name = name;
+    device_config.type = "Bench";
+    device_config.channel_count = channels;
+    device_config.sample_rate = rate;
+    lsltemplate::StreamThread::Config stream_config;
+    stream_config.chunk_duration = chunk_ms / 1000.0;
+    stream_config.decoupled = options.decoupled;
+
+    lsltemplate::StreamThread stream(std::make_unique<StampingDevice>(device_config), stream_config);
+    if (!stream.start()) {
+        std::cerr << "Failed to start stream " << name << std::endl;
+        return result;
+    }
+
+    auto found = lsl::resolve_stream("name", name, 1, 5.0);
+    if (found.empty()) {
+        std::cerr << "Could not resolve stream " << name << std::endl;
+        stream.stop();
+        return result;
+    }
+
+    lsl::stream_inlet inlet(found.front());
+    inlet.open_stream(5.0);
+    const double correction = inlet.time_correction(5.0);
+
+    // Let the pipeline settle before measuring
+    std::vector<float> data(static_cast<std::size_t>(channels) * 4096);
+    std::vector<double> timestamps(4096);
+    const auto warmup_end = std::chrono::steady_clock::now() + std::chrono::milliseconds(500);
+    while (std::chrono::steady_clock::now() < warmup_end) {
+        inlet.pull_chunk_multiplexed(data.data(), timestamps.data(), data.size(), timestamps.size(), 0.05);
+    }
+
+    std::vector<double> latencies;
+    latencies.reserve(static_cast<std::size_t>(rate * options.duration * 1.2) + 1);
+
+    const double cpu_start = processCpuSeconds();
+    const auto start = std::chrono::steady_clock::now();
+    const auto end = start + std::chrono::duration<double>(options.duration);
+
+    while (std::chrono::steady_clock::now() < end) {
+        const std::size_t elements = inlet.pull_chunk_multiplexed(
+            data.data(), timestamps.data(), data.size(), timestamps.size(), 0.05);
+        const double now = lsl::local_clock();
+        const std::size_t samples = elements / static_cast<std::size_t>(channels);
+        for (std::size_t i = 0; i < samples; ++i) {
+            latencies.push_back(now - (timestamps[i] + correction));
+        }
+        result.samples += samples;
+    }
+
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    // liblsl runs the outlet's and the inlet's I/O on threads of its own, so
+    // the producer side cannot be told apart from the consumer side
+    const double process_cpu = processCpuSeconds() - cpu_start;
+
+    stream.stop();
+
+    std::sort(latencies.begin(), latencies.end());
+    result.duration = elapsed;
+    result.samples_per_second = static_cast<double>(result.samples) / elapsed;
+    result.cpu_percent = 100.0 * process_cpu / elapsed;
+    result.p50_ms = percentile(latencies, 0.50) * 1000.0;
+    result.p99_ms = percentile(latencies, 0.99) * 1000.0;
+    result.p999_ms = percentile(latencies, 0.999) * 1000.0;
+    result.max_ms = latencies.empty() ? 0.0 : latencies.back() * 1000.0;
+    return result;
+}
+
+// Median wall time of `repeats` calls to fn, in milliseconds
+template <typename F>
+double medianMs(int repeats, F&& fn) {
+    std::vector<double> times;
+    for (int i = 0; i < std::max(1, repeats); ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        fn();
+        times.push_back(std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count());
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+StartupResult runStartupCase(const Options& options, int channels) {
+    StartupResult result;
+    result.channels = channels;
+
+    // A full layout, as loaded from a channel-layout file
+    lsltemplate::DeviceInfo info;
+    info.name = "lsltemplate_startup_" + std::to_string(channels);
+    info.type = "EEG";
+    info.channel_count = channels;
+    info.sample_rate = 1000.0;
+    info.source_id = info.name;
+    info.channel_layout.reserve(static_cast<std::size_t>(channels));
+    for (int i = 0; i < channels; ++i) {
+        const double angle = 0.01 * static_cast<double>(i);
+        info.channel_layout.push_back({
+            .label = "E" + std::to_string(i + 1),
+            .unit = "microvolts",
+            .type = "EEG",
+            .location = std::array<double, 3>{90.0 * std::cos(angle), 90.0 * std::sin(angle), 0.1 * i}
+        });
+    }
+
+    result.element_ms = medianMs(options.startup_repeats, [&]() {
+        lsltemplate::makeStreamInfo(info, false);
+    });
+    result.bulk_ms = medianMs(options.startup_repeats, [&]() {
+        lsltemplate::makeStreamInfo(info, true);
+    });
+    result.outlet_ms = medianMs(options.startup_repeats, [&]() {
+        lsltemplate::LSLOutlet outlet(info);
+    });
+    result.xml_bytes = lsltemplate::makeStreamInfo(info).as_xml().size();
+    return result;
+}
+
+void writeStartupJson(std::ostream& out, const std::vector<StartupResult>& results) {
+    out << std::setprecision(6);
+    out << "{\n";
+    out << "  \"lsltemplate_version\": \"" << LSLTEMPLATE_VERSION << "\",\n";
+    out << "  \"liblsl_version\": " << lsl::library_version() << ",\n";
+    out << "  \"startup\": [\n";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const StartupResult& r = results[i];
+        out << "    {\"channels\": " << r.channels
+            << ", \"element_ms\": " << r.element_ms
+            << ", \"bulk_ms\": " << r.bulk_ms
+            << ", \"outlet_ms\": " << r.outlet_ms
+            << ", \"xml_bytes\": " << r.xml_bytes << "}"
+            << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n";
+    out << "}\n";
+}
+
+int runStartup(const Options& options) {
+    const bool table = options.json_path != "-";
+    if (table) {
+        std::cout << std::left
+                  << std::setw(8) << "ch" << std::setw(13) << "element ms" << std::setw(10) << "bulk ms"
+                  << std::setw(12) << "outlet ms" << "xml KiB" << std::endl;
+    }
+
+    std::vector<StartupResult> results;
+    for (int channels : options.startup_channels) {
+        const StartupResult r = runStartupCase(options, channels);
+        results.push_back(r);
+        if (table) {
+            std::cout << std::left << std::fixed << std::setprecision(2)
+                      << std::setw(8) << r.channels << std::setw(13) << r.element_ms
+                      << std::setw(10) << r.bulk_ms << std::setw(12) << r.outlet_ms
+                      << std::setprecision(1) << static_cast<double>(r.xml_bytes) / 1024.0
+                      << std::endl;
+        }
+    }
+
+    if (options.json_path == "-") {
+        writeStartupJson(std::cout, results);
+    } else if (!options.json_path.empty()) {
+        std::ofstream file(options.json_path);
+        if (!file.is_open()) {
+            std::cerr << "Failed to write " << options.json_path << std::endl;
+            return 1;
+        }
+        writeStartupJson(file, results);
+    }
+    return 0;
+}
+
+void writeJson(std::ostream& out, const Options& options, const std::vector<Result>& results) {
+    out << std::setprecision(6);
+    out << "{\n";
+    out << "  \"lsltemplate_version\": \"" << LSLTEMPLATE_VERSION << "\",\n";
+    out << "  \"liblsl_version\": " << lsl::library_version() << ",\n";
+    out << "  \"decoupled\": " << (options.decoupled ? "true" : "false") << ",\n";
+    out << "  \"duration\": " << options.duration << ",\n";
+    out << "  \"results\": [\n";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        out << "    {\"channels\": " << r.channels
+            << ", \"sample_rate\": " << r.sample_rate
+            << ", \"chunk_ms\": " << r.chunk_ms
+            << ", \"chunk_samples\": " << r.chunk_samples
+            << ", \"samples\": " << r.samples
+            << ", \"samples_per_second\": " << r.samples_per_second
+            << ", \"cpu_percent\": " << r.cpu_percent
+            << ", \"latency_ms\": {\"p50\": " << r.p50_ms
+            << ", \"p99\": " << r.p99_ms
+            << ", \"p999\": " << r.p999_ms
+            << ", \"max\": " << r.max_ms << "}}"
+            << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n";
+    out << "}\n";
+}
+
+void printUsage(const char* program_name) {
+    std::cout << "Usage: " << program_name << " [options]\n"
+              << "\n"
+              << "Options:\n"
+              << "  -h, --help           Show this help message\n"
+              << "  --channels LIST      Channel counts (default: 1,8,64)\n"
+              << "  --rates LIST         Sample rates in Hz (default: 100,1000,10000)\n"
+              << "  --chunk-ms LIST      Chunk durations in ms (default: 1,10,100)\n"
+              << "  --duration S         Measured seconds per case (default: 3)\n"
+              << "  --decoupled          Benchmark the decoupled pipeline\n"
+              << "  --json FILE          Write results as JSON to FILE (- for stdout)\n"
+              << "  --startup            Time outlet creation for large channel layouts instead\n"
+              << "  --startup-channels LIST\n"
+              << "                       Channel counts for --startup (default: 1024,4096,16384)\n"
+              << "  --repeats N          Runs per --startup measurement, median reported (default: 5)\n"
+              << std::endl;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+
+        try {
+            if (arg == "-h" || arg == "--help") {
+                printUsage(argv[0]);
+                return 0;
+            } else if (arg == "--channels" && i + 1 < argc) {
+                options.channels = parseList<int>(argv[++i]);
+            } else if (arg == "--rates" && i + 1 < argc) {
+                options.rates = parseList<double>(argv[++i]);
+            } else if (arg == "--chunk-ms" && i + 1 < argc) {
+                options.chunk_ms = parseList<double>(argv[++i]);
+            } else if (arg == "--duration" && i + 1 < argc) {
+                options.duration = std::stod(argv[++i]);
+            } else if (arg == "--decoupled") {
+                options.decoupled = true;
+            } else if (arg == "--json" && i + 1 < argc) {
+                options.json_path = argv[++i];
+            } else if (arg == "--startup") {
+                options.startup = true;
+            } else if (arg == "--startup-channels" && i + 1 < argc) {
+                options.startup_channels = parseList<int>(argv[++i]);
+            } else if (arg == "--repeats" && i + 1 < argc) {
+                options.startup_repeats = std::stoi(argv[++i]);
+            } else {
+                std::cerr << "Unknown option: " << arg << std::endl;
+                printUsage(argv[0]);
+                return 1;
+            }
+        } catch (const std::logic_error&) {  // std::invalid_argument, std::out_of_range
+            std::cerr << "Invalid value for " << arg << ": " << argv[i] << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (options.startup) {
+        return runStartup(options);
+    }
+
+    const bool table = options.json_path != "-";
+    if (table) {
+        std::cout << std::left
+                  << std::setw(6) << "ch" << std::setw(9) << "rate" << std::setw(9) << "chunk"
+                  << std::setw(13) << "samples/s" << std::setw(8) << "cpu%"
+                  << std::setw(10) << "p50 ms" << std::setw(10) << "p99 ms" << "p999 ms" << std::endl;
+    }
+
+    std::vector<Result> results;
+    int index = 0;
+    for (int channels : options.channels) {
+        for (double rate : options.rates) {
+            for (double chunk_ms : options.chunk_ms) {
+                const Result r = runCase(options, channels, rate, chunk_ms, index++);
+                results.push_back(r);
+                if (table) {
+                    std::cout << std::left << std::fixed << std::setprecision(1)
+                              << std::setw(6) << r.channels << std::setw(9) << r.sample_rate
+                              << std::setw(9) << (std::to_string(r.chunk_samples) + "s")
+                              << std::setw(13) << r.samples_per_second << std::setw(8) << r.cpu_percent
+                              << std::setprecision(3)
+                              << std::setw(10) << r.p50_ms << std::setw(10) << r.p99_ms << r.p999_ms
+                              << std::endl;
+                }
+            }
+        }
+    }
+
+    if (options.json_path == "-") {
+        writeJson(std::cout, options, results);
+    } else if (!options.json_path.empty()) {
+        std::ofstream file(options.json_path);
+        if (!file.is_open()) {
+            std::cerr << "Failed to write " << options.json_path << std::endl;
+            return 1;
+        }
+        writeJson(file, options, results);
+    }
+
+    return 0;
+}
@@ -6,14 +6,26 @@
  * useful for servers, embedded systems, or automated testing.
  */
 
+#include <lsltemplate/ChannelLayout.hpp>
 #include <lsltemplate/Config.hpp>
+#include <lsltemplate/ConfigWatcher.hpp>
+#include <lsltemplate/Decimator.hpp>
 #include <lsltemplate/Device.hpp>
+#include <lsltemplate/FileReplayDevice.hpp>
+#include <lsltemplate/FilterChain.hpp>
+#include <lsltemplate/StreamManager.hpp>
 #include <lsltemplate/StreamThread.hpp>
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <csignal>
+#include <iomanip>
 #include <iostream>
+#include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
 namespace {
 
@@ -29,11 +41,54 @@ void printUsage(const char* program_name) {
               << "\n"
               << "Options:\n"
               << "  -h, --help           Show this help message\n"
-              << "  -c, --config FILE    Load configuration from FILE\n"
+              << "  -c, --config FILE    Load configuration from FILE, applying later edits\n"
               << "  -n, --name NAME      Stream name (default: LSLTemplate)\n"
               << "  -t, --type TYPE      Stream type (default: Counter)\n"
               << "  -r, --rate RATE      Sample rate in Hz (default: 10)\n"
               << "  --channels N         Number of channels (default: 1)\n"
+              << "  --channel-layout FILE\n"
+              << "                       Channel labels, units, types and locations (CSV)\n"
+              << "  -f, --format FMT     Sample format: float32, double64, int64, int32,\n"
+              << "                       int16, int8 or string (default: float32)\n"
+              << "  --chunk-duration S   Seconds per device read and outlet chunk (default: 0.1)\n"
+              << "  --adaptive-chunk     Resize chunks at runtime to meet --latency-target\n"
+              << "  --latency-target S   Adaptive chunk duration to aim for (default: 0.02)\n"
+              << "  --decoupled          Publish from a separate thread via a chunk ring\n"
+              << "  --ring-capacity N    Chunks buffered when decoupled (default: 32)\n"
+              << "  --overflow POLICY    block, drop-oldest or drop-newest (default: block)\n"
+              << "  --dejitter           Stamp samples from an online clock-drift fit\n"
+              << "  --pace               Release chunks at the nominal rate\n"
+              << "  --spin-us N          Busy-wait N us before pacing deadlines (default: 0)\n"
+              << "  --gate               Hold data back until an inlet connects\n"
+              << "  --preroll S          Seconds delivered to the first inlet when gating (default: 2)\n"
+              << "  --filters LIST       Biquads applied before publishing, e.g.\n"
+              << "                       highpass:0.5,notch:50,lowpass:40 (see LSLTemplate.cfg)\n"
+              << "  --decimate LIST      Also publish copies at rate / factor, e.g. 10,100\n"
+              << "  --record PATH        Also write the stream to local segment files at PATH\n"
+              << "  --waveform LIST      Synthetic signal per channel: sine, square, chirp,\n"
+              << "                       pink or counter (comma-separated, last repeats)\n"
+              << "  --amplitude LIST     Amplitude per channel (default: 1)\n"
+              << "  --frequency LIST     Frequency per channel in Hz (default: 10)\n"
+              << "  --device-clock PPM   Stamp chunks from a simulated device clock running\n"
+              << "                       PPM parts per million fast (negative: slow)\n"
+              << "  --replay FILE        Stream a recording or CSV file instead of the mock device\n"
+              << "  --speed X            Replay speed factor, or max for as fast as possible\n"
+              << "  --loop               Restart the replay at the end of the file\n"
+              << "  --reconnect          Reconnect the device after read errors, keeping the outlet\n"
+              << "  --rate-tolerance X   Report device rates more than X (fraction) off nominal,\n"
+              << "                       0 = off (default: 0.05)\n"
+              << "  --stall-factor N     Report gaps longer than N chunk periods, 0 = off (default: 5)\n"
+              << "  --sched POLICY[:P]   Acquisition thread scheduling: default, fifo or rr,\n"
+              << "                       with real-time priority P (default: 50), e.g. fifo:80\n"
+              << "  --cpus LIST          Pin the acquisition thread to CPUs, e.g. 2 or 0-3,6\n"
+              << "  --publisher-sched POLICY[:P]\n"
+              << "                       Publisher thread scheduling when decoupled\n"
+              << "  --publisher-cpus LIST\n"
+              << "                       Pin the publisher thread to CPUs\n"
+              << "  --lock-memory        Lock the process in RAM (mlockall)\n"
+              << "  --stats-interval S   Print throughput and timing statistics every S seconds\n"
+              << "  --workers N          Worker threads when the config file defines several\n"
+              << "                       [Stream.N] sections (default: min(4, cores))\n"
               << "\n"
               << "Example:\n"
               << "  " << program_name << " --name MyDevice --rate 256 --channels 8\n"
@@ -48,12 +103,393 @@ void statusCallback(const std::string& message, bool is_error) {
     }
 }
 
+// One-line summary of the interval between two snapshots
+void printStats(const lsltemplate::StreamStats& now, const lsltemplate::StreamStats& previous) {
+    const double interval = now.elapsed - previous.elapsed;
+    const double rate = interval > 0.0
+        ? static_cast<double>(now.samples_pushed - previous.samples_pushed) / interval
+        : 0.0;
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "[STATS] " << rate << " Hz (avg " << now.effective_rate << "), "
+              << now.samples_pushed << " samples, " << now.chunks_pushed << " chunks, "
+              << now.bytes_pushed / 1024 << " KiB, "
+              << std::setprecision(3)
+              << "getData p99 " << now.get_data.percentile(0.99) * 1000.0 << " ms, "
+              << "push p99 " << now.push_chunk.percentile(0.99) * 1000.0 << " ms, "
+              << now.overruns << " overruns, chunk " << now.chunk_samples << ", consumers "
+              << (now.has_consumers ? "yes" : "no") << " (" << now.consumer_changes << " changes)";
+    if (now.samples_gated > 0) {
+        std::cout << ", " << now.samples_gated << " gated";
+    }
+    if (now.delivered_rate > 0.0) {
+        std::cout << std::setprecision(1) << ", device " << now.delivered_rate << " Hz"
+                  << (now.rate_deviating ? " (OFF NOMINAL)" : "");
+    }
+    if (now.stalls > 0) {
+        std::cout << ", " << now.stalls << " stalls";
+    }
+    if (now.since_data > 1.0) {
+        std::cout << std::setprecision(1) << ", no data for " << now.since_data << " s";
+    }
+    if (now.reconnects > 0) {
+        std::cout << std::setprecision(3) << ", " << now.reconnects << " reconnects (recovery max "
+                  << now.recovery.percentile(1.0) * 1000.0 << " ms, ~"
+                  << now.samples_missed << " samples missed)";
+    }
+    std::cout << std::defaultfloat << std::endl;
+}
+
+// Create a mock device for one stream (replace with your actual device).
+// Returns nullptr if the synthetic signal settings are invalid.
+std::unique_ptr<lsltemplate::MockDevice> makeDevice(
+    const lsltemplate::AppConfig& config,
+    bool blocking
+) {
+    std::vector<lsltemplate::ChannelSignal> signals;
+    if (!config.waveform.empty()) {
+        auto parsed = lsltemplate::parseChannelSignals(
+            config.waveform, config.amplitude, config.frequency,
+            config.phase, config.chirp_end);
+        if (!parsed) {
+            std::cerr << "Invalid synthetic signal settings for " << config.stream_name << std::endl;
+            return nullptr;
+        }
+        signals = std::move(*parsed);
+    }
+
+    lsltemplate::MockDevice::Config device_config{
+        .name = config.stream_name,
+        .type = config.stream_type,
+        .channel_count = config.channel_count,
+        .sample_rate = config.sample_rate,
+        .start_value = config.device_param,
+        .format = config.sample_format,
+        .device_clock = config.device_clock,
+        .clock_drift_ppm = config.clock_drift_ppm,
+        .signals = std::move(signals),
+        .chirp_period = config.chirp_period,
+        .seed = config.seed,
+        .pacing_spin = std::chrono::microseconds(config.pacing_spin_us),
+        .blocking = blocking
+    };
+    return std::make_unique<lsltemplate::MockDevice>(device_config);
+}
+
+// Create a device replaying config.replay. Returns nullptr if it cannot be loaded.
+std::unique_ptr<lsltemplate::FileReplayDevice> makeReplayDevice(
+    const lsltemplate::AppConfig& config,
+    bool blocking
+) {
+    auto device = std::make_unique<lsltemplate::FileReplayDevice>(lsltemplate::FileReplayDevice::Config{
+        .path = config.replay,
+        .speed = config.replay_speed,
+        .loop = config.replay_loop,
+        .type = config.stream_type,
+        .name = config.stream_name,
+        .format = config.sample_format,
+        .blocking = blocking
+    });
+    if (!device->isValid()) {
+        std::cerr << "Cannot replay " << config.replay << ": " << device->error() << std::endl;
+        return nullptr;
+    }
+    return device;
+}
+
+// Parse POLICY[:PRIORITY] into scheduling; false if invalid
+bool parseScheduling(const std::string& value, lsltemplate::ThreadScheduling& scheduling) {
+    const auto colon = value.find(':');
+    const auto policy = lsltemplate::parseSchedulingPolicy(value.substr(0, colon));
+    if (!policy) {
+        return false;
+    }
+    scheduling.policy = *policy;
+    if (colon != std::string::npos) {
+        scheduling.priority = std::stoi(value.substr(colon + 1));
+    }
+    return true;
+}
+
+// Filter stages of a stream. Returns nullopt if the list is invalid.
+std::optional<std::vector<lsltemplate::FilterSpec>> filterSpecs(const lsltemplate::AppConfig& config) {
+    auto filters = lsltemplate::parseFilters(config.filters);
+    if (!filters) {
+        std::cerr << "Invalid filters for " << config.stream_name << ": " << config.filters << std::endl;
+    }
+    return filters;
+}
+
+// Per-channel metadata of a stream. Returns nullopt if the layout file
+// cannot be loaded.
+std::optional<std::vector<lsltemplate::ChannelDescription>> channelLayout(
+    const lsltemplate::AppConfig& config
+) {
+    if (config.channel_layout.empty()) {
+        return std::vector<lsltemplate::ChannelDescription>{};
+    }
+    const lsltemplate::ChannelLayout layout(config.channel_layout);
+    if (!layout.isValid()) {
+        std::cerr << "Invalid channel layout for " << config.stream_name << ": " << layout.error()
+                  << std::endl;
+        return std::nullopt;
+    }
+    return layout.channels();
+}
+
+// Local recording settings of a stream
+lsltemplate::Recorder::Config recordingConfig(const lsltemplate::AppConfig& config) {
+    return {
+        .path = config.record,
+        .segment_bytes = static_cast<std::size_t>(std::max(1, config.record_segment_mb)) << 20
+    };
+}
+
+// Stream thread settings of a stream. Returns nullopt if they are invalid.
+std::optional<lsltemplate::StreamThread::Config> streamConfig(const lsltemplate::AppConfig& config) {
+    const auto filters = filterSpecs(config);
+    const auto decimation = lsltemplate::parseDecimation(config.decimate);
+    const auto layout = channelLayout(config);
+    if (!filters || !layout) {
+        return std::nullopt;
+    }
+    if (!decimation) {
+        std::cerr << "Invalid decimation factors: " << config.decimate << std::endl;
+        return std::nullopt;
+    }
+
+    return lsltemplate::StreamThread::Config{
+        .chunk_duration = config.chunk_duration,
+        .max_buffered = config.max_buffered,
+        .adaptive_chunk = config.adaptive_chunk,
+        .latency_target = config.latency_target,
+        .cpu_budget = config.cpu_budget,
+        .decoupled = config.decoupled,
+        .ring_capacity = static_cast<size_t>(config.ring_capacity),
+        .overflow_policy = config.overflow_policy,
+        .dejitter = config.dejitter,
+        .pace = config.pace,
+        .pacing_spin = std::chrono::microseconds(config.pacing_spin_us),
+        .reconnect = config.reconnect,
+        .reconnect_delay = config.reconnect_delay,
+        .reconnect_max_delay = config.reconnect_max_delay,
+        .reconnect_timeout = config.reconnect_timeout,
+        .rate_monitor = {
+            .window = config.rate_window,
+            // A replay at another speed is not meant to keep the nominal rate
+            .tolerance = config.replay.empty() || config.replay_speed == 1.0 ? config.rate_tolerance : 0.0,
+            .stall_factor = config.stall_factor
+        },
+        .gate_on_consumers = config.gate_on_consumers,
+        .preroll = config.preroll,
+        .filters = *filters,
+        .decimation = *decimation,
+        .channel_layout = *layout,
+        .splits = config.splits,
+        .recording = recordingConfig(config),
+        .preview = {},  // No display to feed
+        .acquisition_scheduling = config.acquisition_scheduling,
+        .publisher_scheduling = config.publisher_scheduling,
+        .lock_memory = config.lock_memory
+    };
+}
+
+// Device and stream thread of single-stream mode, not yet started.
+// Returns nullptr if the settings are invalid.
+std::unique_ptr<lsltemplate::StreamThread> makeStream(const lsltemplate::AppConfig& config) {
+    std::unique_ptr<lsltemplate::IDevice> device;
+    if (config.replay.empty()) {
+        auto mock = makeDevice(config, true);
+        if (!mock) {
+            return nullptr;
+        }
+        if (auto* generator = mock->getGenerator()) {
+            std::cout << "Signal: " << config.waveform << " (" << generator->isa() << ")" << std::endl;
+        }
+        device = std::move(mock);
+    } else {
+        auto replay = makeReplayDevice(config, true);
+        if (!replay) {
+            return nullptr;
+        }
+        std::cout << "Replay: " << config.replay << ", " << replay->sampleCount() << " samples, "
+                  << replay->duration() << " s at speed ";
+        if (config.replay_speed > 0) {
+            std::cout << config.replay_speed;
+        } else {
+            std::cout << "max";
+        }
+        std::cout << (config.replay_loop ? ", looping" : "") << std::endl;
+        device = std::move(replay);
+    }
+
+    const auto stream_config = streamConfig(config);
+    if (!stream_config) {
+        return nullptr;
+    }
+
+    const auto info = device->getInfo();
+    std::cout << "Stream: " << info.name << " (" << info.type << ")" << std::endl;
+    std::cout << "Channels: " << info.channel_count << " @ " << info.sample_rate << " Hz ("
+              << lsltemplate::toString(info.format) << ")" << std::endl;
+
+    return std::make_unique<lsltemplate::StreamThread>(
+        std::move(device), *stream_config, statusCallback);
+}
+
+// Re-read the configuration file of a running stream and apply what can be
+// changed in place. Returns the new configuration if the stream has to be
+// recreated for it; current is updated otherwise.
+std::optional<lsltemplate::AppConfig> reloadConfig(
+    const std::string& path,
+    lsltemplate::AppConfig& current,
+    lsltemplate::StreamThread& stream
+) {
+    std::string error;
+    const auto loaded = lsltemplate::ConfigManager::loadAll(path, &error);
+    if (!loaded) {
+        std::cerr << "Failed to reload config file: " << path << " (" << error
+                  << "); keeping the current settings" << std::endl;
+        return std::nullopt;
+    }
+    if (loaded->size() > 1) {
+        std::cerr << "Several streams need a restart; keeping the current stream" << std::endl;
+        return std::nullopt;
+    }
+    const auto& next = loaded->front();
+    if (next == current) {
+        return std::nullopt;
+    }
+    std::cout << "Reloaded configuration from: " << path << std::endl;
+
+    // Everything but these settings leaves the stream as it is
+    auto shape = next;
+    shape.filters = current.filters;
+    shape.chunk_duration = current.chunk_duration;
+    shape.device_param = current.device_param;
+    shape.stats_interval = current.stats_interval;
+    if (shape != current) {
+        return next;
+    }
+
+    const auto stream_config = streamConfig(next);
+    if (!stream_config) {
+        return std::nullopt;
+    }
+    const auto device_param = next.device_param != current.device_param
+        ? std::optional<int>(next.device_param) : std::nullopt;
+    switch (stream.update(*stream_config, device_param)) {
+        case lsltemplate::StreamThread::UpdateResult::NeedsRestart:
+            return next;
+        case lsltemplate::StreamThread::UpdateResult::Invalid:
+            return std::nullopt;
+        case lsltemplate::StreamThread::UpdateResult::Applied:
+        case lsltemplate::StreamThread::UpdateResult::Unchanged:
+            break;
+    }
+    current = next;
+    return std::nullopt;
+}
+
+// Settings of a stream that the shared worker pool does not implement, where
+// they differ from the defaults; host-wide ones where they differ from host
+std::vector<std::string> unsupportedSettings(const lsltemplate::AppConfig& config,
+                                             const lsltemplate::AppConfig& host) {
+    const lsltemplate::AppConfig defaults;
+    std::vector<std::string> keys;
+    const auto check = [&keys](bool differs, const char* key) {
+        if (differs) {
+            keys.push_back(key);
+        }
+    };
+    check(config.chunk_duration != defaults.chunk_duration, "chunk_duration");
+    check(config.max_buffered != defaults.max_buffered, "max_buffered");
+    check(config.adaptive_chunk != defaults.adaptive_chunk, "adaptive_chunk");
+    check(config.decoupled != defaults.decoupled, "decoupled");
+    check(config.ring_capacity != defaults.ring_capacity, "ring_capacity");
+    check(config.overflow_policy != defaults.overflow_policy, "overflow_policy");
+    check(config.dejitter != defaults.dejitter, "dejitter");
+    check(config.pace != defaults.pace, "pace");
+    check(config.reconnect != defaults.reconnect, "reconnect");
+    check(config.device_clock != defaults.device_clock, "device_clock");
+    check(config.rate_window != defaults.rate_window ||
+          config.rate_tolerance != defaults.rate_tolerance ||
+          config.stall_factor != defaults.stall_factor, "rate monitoring");
+    check(!config.decimate.empty(), "decimate");
+    check(!config.splits.empty(), "splits");
+    check(config.stats_interval != defaults.stats_interval, "stats_interval");
+    check(config.publisher_scheduling != defaults.publisher_scheduling, "publisher scheduling");
+    check(config.gate_on_consumers != host.gate_on_consumers || config.preroll != host.preroll,
+          "gating (taken from the first stream)");
+    check(config.acquisition_scheduling != host.acquisition_scheduling,
+          "acquisition scheduling (taken from the first stream)");
+    check(config.lock_memory != host.lock_memory, "lock_memory (taken from the first stream)");
+    return keys;
+}
+
+// Serve every stream from a shared worker pool until shutdown
+int runStreams(const std::vector<lsltemplate::AppConfig>& configs, std::size_t workers) {
+    // Gating and real-time settings are host-wide, taken from the defaults
+    lsltemplate::StreamManager manager(
+        lsltemplate::StreamManager::Config{
+            .workers = workers,
+            .gate_on_consumers = configs.front().gate_on_consumers,
+            .preroll = configs.front().preroll,
+            .scheduling = configs.front().acquisition_scheduling,
+            .lock_memory = configs.front().lock_memory
+        },
+        statusCallback);
+
+    for (const auto& config : configs) {
+        std::unique_ptr<lsltemplate::IDevice> device;
+        if (config.replay.empty()) {
+            device = makeDevice(config, false);
+        } else {
+            device = makeReplayDevice(config, false);
+        }
+        const auto filters = filterSpecs(config);
+        const auto layout = channelLayout(config);
+        if (!device || !filters || !layout) {
+            return 1;
+        }
+        if (const auto keys = unsupportedSettings(config, configs.front()); !keys.empty()) {
+            std::cerr << "Not supported with several streams, ignored for " << config.stream_name << ":";
+            for (std::size_t i = 0; i < keys.size(); ++i) {
+                std::cerr << (i == 0 ? " " : ", ") << keys[i];
+            }
+            std::cerr << std::endl;
+        }
+        const auto info = device->getInfo();
+        std::cout << "Stream: " << info.name << " (" << info.type << "), "
+                  << info.channel_count << " ch @ " << info.sample_rate << " Hz ("
+                  << lsltemplate::toString(info.format) << ")" << std::endl;
+        manager.add(std::move(device), recordingConfig(config), *filters, *layout);
+    }
+    std::cout << configs.size() << " streams on " << manager.workerCount() << " worker threads" << std::endl;
+    std::cout << "Press Ctrl+C to stop..." << std::endl;
+
+    if (!manager.startAll()) {
+        std::cerr << "Failed to start some streams" << std::endl;
+    }
+
+    while (!g_shutdown && manager.runningCount() > 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    manager.stopAll();
+
+    std::cout << "Shutdown complete." << std::endl;
+    return 0;
+}
+
 } // anonymous namespace
 
 int main(int argc, char* argv[]) {
     // Parse command line arguments
     lsltemplate::AppConfig config;
     std::string config_file;
+    std::size_t workers = 0;
+    std::optional<double> stats_interval;  // Overrides the configuration
 
     for (int i = 1; i < argc; ++i) {
         std::string arg = argv[i];
@@ -71,6 +507,95 @@ int main(int argc, char* argv[]) {
             config.sample_rate = std::stod(argv[++i]);
         } else if (arg == "--channels" && i + 1 < argc) {
             config.channel_count = std::stoi(argv[++i]);
+        } else if (arg == "--channel-layout" && i + 1 < argc) {
+            config.channel_layout = argv[++i];
+        } else if ((arg == "-f" || arg == "--format") && i + 1 < argc) {
+            auto format = lsltemplate::parseSampleFormat(argv[++i]);
+            if (!format) {
+                std::cerr << "Unknown sample format: " << argv[i] << std::endl;
+                return 1;
+            }
+            config.sample_format = *format;
+        } else if (arg == "--chunk-duration" && i + 1 < argc) {
+            config.chunk_duration = std::stod(argv[++i]);
+        } else if (arg == "--adaptive-chunk") {
+            config.adaptive_chunk = true;
+        } else if (arg == "--latency-target" && i + 1 < argc) {
+            config.latency_target = std::stod(argv[++i]);
+        } else if (arg == "--decoupled") {
+            config.decoupled = true;
+        } else if (arg == "--dejitter") {
+            config.dejitter = true;
+        } else if (arg == "--stats-interval" && i + 1 < argc) {
+            stats_interval = std::stod(argv[++i]);
+        } else if (arg == "--workers" && i + 1 < argc) {
+            workers = static_cast<std::size_t>(std::stoul(argv[++i]));
+        } else if (arg == "--pace") {
+            config.pace = true;
+        } else if (arg == "--spin-us" && i + 1 < argc) {
+            config.pacing_spin_us = std::stoi(argv[++i]);
+        } else if (arg == "--gate") {
+            config.gate_on_consumers = true;
+        } else if (arg == "--preroll" && i + 1 < argc) {
+            config.preroll = std::stod(argv[++i]);
+        } else if (arg == "--replay" && i + 1 < argc) {
+            config.replay = argv[++i];
+        } else if (arg == "--speed" && i + 1 < argc) {
+            const std::string speed = argv[++i];
+            config.replay_speed = speed == "max" ? 0.0 : std::stod(speed);
+        } else if (arg == "--loop") {
+            config.replay_loop = true;
+        } else if (arg == "--reconnect") {
+            config.reconnect = true;
+        } else if (arg == "--rate-tolerance" && i + 1 < argc) {
+            config.rate_tolerance = std::stod(argv[++i]);
+        } else if (arg == "--stall-factor" && i + 1 < argc) {
+            config.stall_factor = std::stod(argv[++i]);
+        } else if (arg == "--filters" && i + 1 < argc) {
+            config.filters = argv[++i];
+        } else if (arg == "--decimate" && i + 1 < argc) {
+            config.decimate = argv[++i];
+        } else if (arg == "--record" && i + 1 < argc) {
+            config.record = argv[++i];
+        } else if ((arg == "--sched" || arg == "--publisher-sched") && i + 1 < argc) {
+            auto& scheduling = arg == "--sched"
+                ? config.acquisition_scheduling : config.publisher_scheduling;
+            if (!parseScheduling(argv[++i], scheduling)) {
+                std::cerr << "Unknown scheduling policy: " << argv[i] << std::endl;
+                return 1;
+            }
+        } else if ((arg == "--cpus" || arg == "--publisher-cpus") && i + 1 < argc) {
+            auto cpus = lsltemplate::parseCpuList(argv[++i]);
+            if (!cpus) {
+                std::cerr << "Invalid CPU list: " << argv[i] << std::endl;
+                return 1;
+            }
+            (arg == "--cpus" ? config.acquisition_scheduling : config.publisher_scheduling).cpus =
+                std::move(*cpus);
+        } else if (arg == "--lock-memory") {
+            config.lock_memory = true;
+        } else if (arg == "--waveform" && i + 1 < argc) {
+            config.waveform = argv[++i];
+        } else if (arg == "--amplitude" && i + 1 < argc) {
+            config.amplitude = argv[++i];
+        } else if (arg == "--frequency" && i + 1 < argc) {
+            config.frequency = argv[++i];
+        } else if (arg == "--device-clock" && i + 1 < argc) {
+            config.device_clock = true;
+            config.clock_drift_ppm = std::stod(argv[++i]);
+        } else if (arg == "--ring-capacity" && i + 1 < argc) {
+            config.ring_capacity = std::stoi(argv[++i]);
+            if (config.ring_capacity < 1) {
+                std::cerr << "Ring capacity must be at least 1 chunk: " << argv[i] << std::endl;
+                return 1;
+            }
+        } else if (arg == "--overflow" && i + 1 < argc) {
+            auto policy = lsltemplate::parseOverflowPolicy(argv[++i]);
+            if (!policy) {
+                std::cerr << "Unknown overflow policy: " << argv[i] << std::endl;
+                return 1;
+            }
+            config.overflow_policy = *policy;
         } else {
             std::cerr << "Unknown option: " << arg << std::endl;
             printUsage(argv[0]);
@@ -79,13 +604,16 @@ int main(int argc, char* argv[]) {
     }
 
     // Load config file if specified
+    std::vector<lsltemplate::AppConfig> streams;
     if (!config_file.empty()) {
-        auto loaded = lsltemplate::ConfigManager::load(config_file);
+        std::string error;
+        auto loaded = lsltemplate::ConfigManager::loadAll(config_file, &error);
         if (loaded) {
-            config = *loaded;
+            streams = std::move(*loaded);
+            config = streams.front();
             std::cout << "Loaded configuration from: " << config_file << std::endl;
         } else {
-            std::cerr << "Failed to load config file: " << config_file << std::endl;
+            std::cerr << "Failed to load config file: " << config_file << " (" << error << ")" << std::endl;
             return 1;
         }
     }
@@ -95,35 +623,83 @@ int main(int argc, char* argv[]) {
     std::signal(SIGTERM, signalHandler);
 
     std::cout << "LSL Template CLI" << std::endl;
-    std::cout << "Stream: " << config.stream_name << " (" << config.stream_type << ")" << std::endl;
-    std::cout << "Channels: " << config.channel_count << " @ " << config.sample_rate << " Hz" << std::endl;
-    std::cout << "Press Ctrl+C to stop..." << std::endl;
 
-    // Create mock device (replace with your actual device)
-    lsltemplate::MockDevice::Config device_config{
-        .name = config.stream_name,
-        .type = config.stream_type,
-        .channel_count = config.channel_count,
-        .sample_rate = config.sample_rate,
-        .start_value = config.device_param
-    };
-    auto device = std::make_unique<lsltemplate::MockDevice>(device_config);
+    // Several [Stream.N] sections: share a worker pool instead of a thread each
+    if (streams.size() > 1) {
+        if (stats_interval) {
+            std::cerr << "Not supported with several streams, ignored: --stats-interval" << std::endl;
+        }
+        return runStreams(streams, workers);
+    }
 
-    // Create and start the stream thread
-    lsltemplate::StreamThread stream(std::move(device), statusCallback);
+    auto stream = makeStream(config);
+    if (!stream) {
+        return 1;
+    }
+    std::cout << "Press Ctrl+C to stop..." << std::endl;
 
-    if (!stream.start()) {
+    if (!stream->start()) {
         std::cerr << "Failed to start streaming" << std::endl;
         return 1;
     }
 
-    // Wait for shutdown signal
-    while (!g_shutdown && stream.isRunning()) {
+    // Pick up edits to the configuration file while streaming
+    std::atomic<bool> reload{false};
+    std::unique_ptr<lsltemplate::ConfigWatcher> watcher;
+    if (!config_file.empty()) {
+        watcher = std::make_unique<lsltemplate::ConfigWatcher>(
+            config_file, [&reload] { reload = true; }, statusCallback);
+        watcher->start();
+    }
+
+    // Wait for shutdown signal, reporting statistics if requested
+    const auto interval = [&] {
+        return std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(stats_interval.value_or(config.stats_interval)));
+    };
+    auto previous_stats = stream->getStats();
+    auto next_report = std::chrono::steady_clock::now() + interval();
+    while (!g_shutdown && stream->isRunning()) {
         std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        if (reload.exchange(false)) {
+            auto next = reloadConfig(config_file, config, *stream);
+            if (next) {
+                // Prepared before the old outlet goes, so the gap is just stop + start
+                auto replacement = makeStream(*next);
+                if (!replacement) {
+                    std::cerr << "Keeping the current stream" << std::endl;
+                } else {
+                    stream->stop();
+                    stream = std::move(replacement);
+                    if (stream->start()) {
+                        config = *next;
+                    } else {
+                        std::cerr << "Failed to start with the new configuration; restoring the previous one"
+                                  << std::endl;
+                        stream = makeStream(config);
+                        if (!stream || !stream->start()) {
+                            std::cerr << "Failed to restart streaming" << std::endl;
+                            return 1;
+                        }
+                    }
+                    previous_stats = stream->getStats();
+                }
+            }
+            next_report = std::chrono::steady_clock::now() + interval();
+        }
+        if (interval().count() > 0 && std::chrono::steady_clock::now() >= next_report) {
+            const auto stats = stream->getStats();
+            printStats(stats, previous_stats);
+            previous_stats = stats;
+            next_report += interval();
+        }
     }
 
     // Clean shutdown
-    stream.stop();
+    if (watcher) {
+        watcher->stop();
+    }
+    stream->stop();
 
     std::cout << "Shutdown complete." << std::endl;
     return 0;
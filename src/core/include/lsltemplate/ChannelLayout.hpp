@@ -0,0 +1,59 @@
+#pragma once
+/**
+ * @file ChannelLayout.hpp
+ * @brief Per-channel metadata for the stream description
+ *
+ * Labels, units, types and sensor locations end up in the <channels>
+ * element of the outlet's stream info, where recorders and viewers pick
+ * them up. They are normally loaded from a channel-layout file.
+ */
+
+#include <array>
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace lsltemplate {
+
+/**
+ * @brief Metadata of one channel; empty fields take the defaults below
+ */
+struct ChannelDescription {
+    std::string label;  ///< Empty = "Ch<n>" (1-based)
+    std::string unit;   ///< Empty = "arbitrary"
+    std::string type;   ///< Empty = the stream type
+    std::optional<std::array<double, 3>> location;  ///< X, Y, Z (XDF: millimetres)
+
+    bool operator==(const ChannelDescription&) const = default;
+};
+
+/**
+ * @brief Channel layout loaded from a CSV or tab-separated file
+ *
+ * The first row names the columns: label (required), and optionally unit,
+ * type and x, y, z; unknown columns are ignored and empty cells take the
+ * ChannelDescription defaults. Every further row describes one channel,
+ * in channel order. Lines starting with '#' are comments. For example:
+ *
+ *     label,unit,type,x,y,z
+ *     Fp1,microvolts,EEG,-29.4,83.9,-7.0
+ *     EOG,microvolts,EOG,,,
+ */
+class ChannelLayout {
+public:
+    explicit ChannelLayout(const std::filesystem::path& path);
+
+    /// Whether the file was loaded; see error() otherwise
+    bool isValid() const { return error_.empty(); }
+    const std::string& error() const { return error_; }
+
+    const std::vector<ChannelDescription>& channels() const { return channels_; }
+
+private:
+    std::vector<ChannelDescription> channels_;
+    std::string error_;
+};
+
+} // namespace lsltemplate
@@ -0,0 +1,122 @@
+#pragma once
+/**
+ * @file ChannelSplit.hpp
+ * @brief Fan-out of channel subsets to separate outlets
+ *
+ * A device carrying several modalities (e.g. EEG, EMG and ECG on one
+ * amplifier) can be published as several streams, each with its own
+ * type, labels and channels, next to the full stream.
+ */
+
+#include "Device.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace lsltemplate {
+
+/**
+ * @brief One outlet carrying a subset of the device's channels
+ */
+struct ChannelSplit {
+    std::string name;                 ///< Stream name; empty = <device name>_<type>
+    std::string type;                 ///< Stream type; empty = the device's
+    std::vector<int> channels;        ///< Device channels (0-based), in outlet order
+    std::vector<std::string> labels;  ///< Per channel; empty = the device's labels
+
+    bool operator==(const ChannelSplit&) const = default;
+};
+
+/// Parse a channel list such as "0-63,70,65"; order is kept, ranges may descend
+std::optional<std::vector<int>> parseChannelList(std::string_view list);
+
+/// Inverse of parseChannelList(), with ascending runs collapsed
+std::string formatChannelList(const std::vector<int>& channels);
+
+/// Why the splits cannot be applied to a device with `channels` channels,
+/// or an empty string if they can
+std::string validateSplits(const std::vector<ChannelSplit>& splits, int channels);
+
+/// Stream description of a split of `parent`
+DeviceInfo splitInfo(const DeviceInfo& parent, const ChannelSplit& split);
+
+/**
+ * @brief Type-erased base of ChannelSplitter: the gather plan
+ *
+ * The channel maps are compiled once into runs of channels that are
+ * contiguous in both the device sample and an output sample, ordered by
+ * their position in the device sample. Splitting a chunk is then a single
+ * sequential pass over it with one block copy per run and sample.
+ */
+class ChannelSplitterBase {
+public:
+    virtual ~ChannelSplitterBase() = default;
+
+    std::size_t outputs() const { return out_channels_.size(); }
+    std::size_t channels(std::size_t output) const { return out_channels_[output]; }
+    std::size_t runs() const { return runs_.size(); }
+
+protected:
+    /// @param splits Valid splits (see validateSplits())
+    /// @param channels Channels of the device
+    ChannelSplitterBase(const std::vector<ChannelSplit>& splits, std::size_t channels);
+
+    struct Run {
+        uint32_t output;  // Split index
+        uint32_t source;  // First channel in the device sample
+        uint32_t target;  // First channel in the output sample
+        uint32_t count;
+    };
+
+    std::size_t in_channels_;
+    std::vector<std::size_t> out_channels_;
+    std::vector<Run> runs_;
+};
+
+/**
+ * @brief Splits channel-interleaved chunks into preallocated per-outlet chunks
+ */
+template <typename T>
+class ChannelSplitter : public ChannelSplitterBase {
+public:
+    /**
+     * @param splits Valid splits (see validateSplits())
+     * @param channels Channels of the device
+     * @param max_samples Largest chunk split() will be given
+     */
+    ChannelSplitter(const std::vector<ChannelSplit>& splits, std::size_t channels,
+                    std::size_t max_samples)
+        : ChannelSplitterBase(splits, channels)
+        , max_samples_(max_samples)
+    {
+        buffers_.reserve(outputs());
+        for (std::size_t i = 0; i < outputs(); ++i) {
+            buffers_.emplace_back(max_samples * out_channels_[i]);
+        }
+    }
+
+    /// Gather `samples` (at most max_samples) device samples into the outputs
+    void split(const T* data, std::size_t samples) {
+        samples = std::min(samples, max_samples_);
+        for (std::size_t s = 0; s < samples; ++s) {
+            const T* in = data + s * in_channels_;
+            for (const Run& run : runs_) {
+                T* out = buffers_[run.output].data() + s * out_channels_[run.output] + run.target;
+                std::copy_n(in + run.source, run.count, out);
+            }
+        }
+    }
+
+    /// Channel-interleaved samples of one output from the last split()
+    const T* output(std::size_t index) const { return buffers_[index].data(); }
+
+private:
+    std::size_t max_samples_;
+    std::vector<std::vector<T>> buffers_;
+};
+
+} // namespace lsltemplate
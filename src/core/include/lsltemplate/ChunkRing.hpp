@@ -0,0 +1,318 @@
+#pragma once
+/**
+ * @file ChunkRing.hpp
+ * @brief Lock-free single-producer/single-consumer ring of sample chunks
+ *
+ * Decouples device acquisition from LSL publishing: the acquisition thread
+ * fills preallocated chunks and hands them to a publisher thread without
+ * locks or allocations.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace lsltemplate {
+
+/**
+ * @brief What the producer does when the ring is full
+ */
+enum class OverflowPolicy {
+    Block,       ///< Wait for the publisher to free a slot
+    DropOldest,  ///< Discard the oldest queued chunk
+    DropNewest   ///< Discard the chunk being committed
+};
+
+/// Parse "block", "drop-oldest" or "drop-newest"
+inline std::optional<OverflowPolicy> parseOverflowPolicy(std::string_view name) {
+    if (name == "block") return OverflowPolicy::Block;
+    if (name == "drop-oldest" || name == "drop_oldest") return OverflowPolicy::DropOldest;
+    if (name == "drop-newest" || name == "drop_newest") return OverflowPolicy::DropNewest;
+    return std::nullopt;
+}
+
+/// Config-file spelling of an overflow policy
+inline const char* toString(OverflowPolicy policy) {
+    switch (policy) {
+        case OverflowPolicy::DropOldest: return "drop-oldest";
+        case OverflowPolicy::DropNewest: return "drop-newest";
+        case OverflowPolicy::Block: break;
+    }
+    return "block";
+}
+
+/**
+ * @brief A block of channel-interleaved samples travelling through the ring
+ */
+template <typename T>
+struct Chunk {
+    std::vector<T> data;      ///< Preallocated sample storage
+    std::size_t samples = 0;  ///< Number of valid samples in data
+    double timestamp = 0.0;   ///< LSL time of the last sample (0 = stamp at push)
+    double sample_interval = 0.0;  ///< Per-sample timestamp spacing (0 = liblsl default)
+};
+
+/**
+ * @brief Ring occupancy counters
+ */
+struct RingStats {
+    std::size_t capacity = 0;    ///< Maximum number of queued chunks
+    std::size_t high_water = 0;  ///< Largest queue depth observed
+    uint64_t committed = 0;      ///< Chunks handed to the publisher
+    uint64_t dropped = 0;        ///< Chunks discarded by the overflow policy
+};
+
+/**
+ * @brief Type-independent part of ChunkRing: slot bookkeeping and counters
+ *
+ * Slots are referenced by index. Two bounded index queues circulate them:
+ * `filled_` (producer -> consumer) and `free_` (consumer -> producer). The
+ * producer always owns one slot to write into and the consumer owns at most
+ * one slot while publishing, so capacity + 2 slots are allocated.
+ */
+class ChunkRingBase {
+public:
+    ChunkRingBase(const ChunkRingBase&) = delete;
+    ChunkRingBase& operator=(const ChunkRingBase&) = delete;
+    virtual ~ChunkRingBase() = default;
+
+    /// Wake any waiting thread and make read() return nullptr once drained
+    void close() {
+        closed_.store(true, std::memory_order_release);
+        produced_.fetch_add(1, std::memory_order_release);
+        produced_.notify_all();
+        consumed_.fetch_add(1, std::memory_order_release);
+        consumed_.notify_all();
+    }
+
+    bool isClosed() const { return closed_.load(std::memory_order_acquire); }
+
+    /// Number of chunks currently waiting for the publisher
+    std::size_t size() const { return filled_.size(); }
+
+    RingStats stats() const {
+        return {
+            .capacity = capacity_,
+            .high_water = high_water_.load(std::memory_order_relaxed),
+            .committed = committed_.load(std::memory_order_relaxed),
+            .dropped = dropped_.load(std::memory_order_relaxed)
+        };
+    }
+
+protected:
+    static constexpr uint32_t kNoSlot = UINT32_MAX;
+
+    ChunkRingBase(std::size_t capacity, OverflowPolicy policy)
+        : capacity_(std::max<std::size_t>(1, capacity))
+        , policy_(policy)
+        , filled_(capacity_)
+        , free_(capacity_ + 2)
+    {
+        // Slot 0 is the producer's initial write slot
+        for (uint32_t i = 1; i < capacity_ + 2; ++i) {
+            free_.push(i);
+        }
+    }
+
+    std::size_t slotCount() const { return capacity_ + 2; }
+
+    /// Producer: publish write_slot_ and pick up the next slot to fill
+    bool commitSlot() {
+        uint32_t spare = kNoSlot;
+
+        if (filled_.size() >= capacity_) {
+            switch (policy_) {
+                case OverflowPolicy::DropNewest:
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                case OverflowPolicy::DropOldest:
+                    // The consumer may win the race for the oldest chunk,
+                    // in which case there is room again anyway.
+                    if (filled_.pop(spare)) {
+                        dropped_.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    break;
+                case OverflowPolicy::Block:
+                    while (filled_.size() >= capacity_) {
+                        const auto seen = consumed_.load(std::memory_order_acquire);
+                        if (isClosed()) {
+                            return false;
+                        }
+                        if (filled_.size() < capacity_) {
+                            break;
+                        }
+                        consumed_.wait(seen, std::memory_order_acquire);
+                    }
+                    break;
+            }
+        }
+
+        // Only the producer pushes, so this cannot fail after the checks above
+        filled_.push(write_slot_);
+        committed_.fetch_add(1, std::memory_order_relaxed);
+
+        const std::size_t depth = filled_.size();
+        if (depth > high_water_.load(std::memory_order_relaxed)) {
+            high_water_.store(depth, std::memory_order_relaxed);
+        }
+
+        produced_.fetch_add(1, std::memory_order_release);
+        produced_.notify_one();
+
+        // At most capacity chunks are queued and the consumer holds at most
+        // one, so a free slot is guaranteed when no spare was recovered.
+        if (spare != kNoSlot) {
+            write_slot_ = spare;
+        } else {
+            while (!free_.pop(write_slot_)) {
+                // Unreachable while the consumer honours read()/release()
+            }
+        }
+        return true;
+    }
+
+    /// Consumer: take the oldest chunk, optionally waiting for one
+    uint32_t acquireSlot(bool wait) {
+        releaseSlot();
+        for (;;) {
+            const auto seen = produced_.load(std::memory_order_acquire);
+            if (filled_.pop(read_slot_)) {
+                consumed_.fetch_add(1, std::memory_order_release);
+                consumed_.notify_one();
+                return read_slot_;
+            }
+            if (!wait || isClosed()) {
+                return kNoSlot;
+            }
+            produced_.wait(seen, std::memory_order_acquire);
+        }
+    }
+
+    /// Consumer: hand the slot obtained from acquireSlot() back to the producer
+    void releaseSlot() {
+        if (read_slot_ != kNoSlot) {
+            free_.push(read_slot_);
+            read_slot_ = kNoSlot;
+        }
+    }
+
+    uint32_t write_slot_ = 0;
+    uint32_t read_slot_ = kNoSlot;
+
+private:
+    /**
+     * @brief Bounded queue of slot indices
+     *
+     * Single pusher; poppers claim entries with a CAS on the head so the
+     * producer can steal the oldest entry under DropOldest. Positions are
+     * 64-bit and never wrap, which rules out ABA.
+     */
+    class IndexQueue {
+    public:
+        explicit IndexQueue(std::size_t capacity) : cells_(capacity) {}
+
+        bool push(uint32_t value) {
+            const uint64_t tail = tail_.load(std::memory_order_relaxed);
+            if (tail - head_.load(std::memory_order_acquire) >= cells_.size()) {
+                return false;
+            }
+            cells_[tail % cells_.size()].store(value, std::memory_order_relaxed);
+            tail_.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool pop(uint32_t& value) {
+            uint64_t head = head_.load(std::memory_order_acquire);
+            for (;;) {
+                if (head == tail_.load(std::memory_order_acquire)) {
+                    return false;
+                }
+                const uint32_t candidate =
+                    cells_[head % cells_.size()].load(std::memory_order_relaxed);
+                if (head_.compare_exchange_weak(head, head + 1, std::memory_order_acq_rel)) {
+                    value = candidate;
+                    return true;
+                }
+            }
+        }
+
+        std::size_t size() const {
+            const uint64_t head = head_.load(std::memory_order_acquire);
+            const uint64_t tail = tail_.load(std::memory_order_acquire);
+            return static_cast<std::size_t>(tail - std::min(head, tail));
+        }
+
+    private:
+        std::vector<std::atomic<uint32_t>> cells_;
+        alignas(64) std::atomic<uint64_t> head_{0};
+        alignas(64) std::atomic<uint64_t> tail_{0};
+    };
+
+    const std::size_t capacity_;
+    const OverflowPolicy policy_;
+    IndexQueue filled_;
+    IndexQueue free_;
+
+    alignas(64) std::atomic<uint32_t> produced_{0};
+    alignas(64) std::atomic<uint32_t> consumed_{0};
+    std::atomic<bool> closed_{false};
+
+    std::atomic<std::size_t> high_water_{0};
+    std::atomic<uint64_t> committed_{0};
+    std::atomic<uint64_t> dropped_{0};
+};
+
+/**
+ * @brief SPSC ring of preallocated chunks
+ *
+ * Producer: fill writeSlot(), then commit(). Consumer: read(), publish the
+ * chunk, then release(). No allocation happens after construction.
+ */
+template <typename T>
+class ChunkRing : public ChunkRingBase {
+public:
+    /**
+     * @param capacity Maximum number of queued chunks
+     * @param chunk_elements Elements (samples * channels) per chunk
+     * @param policy Behaviour when the publisher falls behind
+     */
+    ChunkRing(std::size_t capacity, std::size_t chunk_elements, OverflowPolicy policy)
+        : ChunkRingBase(capacity, policy)
+        , slots_(slotCount())
+    {
+        for (auto& slot : slots_) {
+            slot.data.resize(chunk_elements);
+        }
+    }
+
+    /// Producer: chunk to fill before the next commit()
+    Chunk<T>& writeSlot() { return slots_[write_slot_]; }
+
+    /**
+     * @brief Producer: queue the current write slot for publishing
+     * @return false if the chunk was dropped or the ring was closed
+     */
+    bool commit() { return commitSlot(); }
+
+    /**
+     * @brief Consumer: next chunk to publish
+     * @param wait Block until a chunk is available or the ring is closed
+     * @return Chunk, or nullptr if none is available (or closed and drained)
+     */
+    Chunk<T>* read(bool wait = true) {
+        const uint32_t slot = acquireSlot(wait);
+        return slot == kNoSlot ? nullptr : &slots_[slot];
+    }
+
+    /// Consumer: return the chunk obtained from read()
+    void release() { releaseSlot(); }
+
+private:
+    std::vector<Chunk<T>> slots_;
+};
+
+} // namespace lsltemplate
@@ -0,0 +1,84 @@
+#pragma once
+/**
+ * @file ClockEstimator.hpp
+ * @brief Online mapping from device time to LSL time
+ *
+ * Fits lsl_time = offset + slope * device_time with recursive least squares,
+ * so chunk timestamps can be dejittered and corrected for clock drift while
+ * streaming instead of in post-hoc analysis.
+ */
+
+#include <cstdint>
+
+namespace lsltemplate {
+
+/**
+ * @brief Snapshot of the current clock model, for monitoring
+ */
+struct ClockEstimate {
+    double offset = 0.0;      ///< LSL time minus device time at the latest observation (s)
+    double drift_ppm = 0.0;   ///< Rate error of the device clock relative to LSL (ppm)
+    double jitter = 0.0;      ///< RMS residual of observations around the fit (s)
+    uint64_t updates = 0;     ///< Number of observations incorporated
+};
+
+/**
+ * @brief Recursive least squares estimator of device clock vs lsl::local_clock()
+ *
+ * Each observation pairs a device timestamp with the LSL time at which the
+ * corresponding sample was observed. Older observations are discounted by a
+ * forgetting factor so the fit tracks slow drift. Both axes are expressed
+ * relative to the first observation to keep the update well conditioned.
+ * O(1) time and memory per update; not thread-safe.
+ */
+class ClockEstimator {
+public:
+    /**
+     * @param forgetting_factor Weight decay per observation, in (0, 1];
+     *        the fit effectively spans 1 / (1 - factor) observations
+     */
+    explicit ClockEstimator(double forgetting_factor = 0.999);
+
+    /// Forget all observations (e.g. after a device reconnect)
+    void reset();
+
+    /**
+     * @brief Incorporate one observation
+     * @param device_time Device-side time of a sample (s)
+     * @param lsl_time lsl::local_clock() time at which it was observed (s)
+     */
+    void update(double device_time, double lsl_time);
+
+    /// Map a device timestamp to LSL time using the current fit
+    double map(double device_time) const;
+
+    /// LSL seconds per device second (1.0 for a perfect device clock)
+    double slope() const { return slope_; }
+
+    /// Whether at least one observation has been incorporated
+    bool valid() const { return updates_ > 0; }
+
+    ClockEstimate estimate() const;
+
+private:
+    double lambda_;
+
+    // Origin of the centred coordinate system
+    double x0_ = 0.0;
+    double y0_ = 0.0;
+
+    // Model parameters: y - y0 = intercept_ + slope_ * (x - x0)
+    double intercept_ = 0.0;
+    double slope_ = 1.0;
+
+    // Inverse information matrix (symmetric 2x2)
+    double p00_ = 0.0;
+    double p01_ = 0.0;
+    double p11_ = 0.0;
+
+    double last_x_ = 0.0;
+    double residual_sq_ = 0.0;
+    uint64_t updates_ = 0;
+};
+
+} // namespace lsltemplate
@@ -6,9 +6,15 @@
  * Provides platform-independent configuration loading and saving.
  */
 
+#include "ChannelSplit.hpp"
+#include "ChunkRing.hpp"
+#include "SampleFormat.hpp"
+#include "ThreadScheduling.hpp"
+#include <cstdint>
 #include <filesystem>
 #include <optional>
 #include <string>
+#include <vector>
 
 namespace lsltemplate {
 
@@ -22,7 +28,73 @@ struct AppConfig {
     std::string stream_type = "Counter";
     int channel_count = 1;
     double sample_rate = 10.0;
+    SampleFormat sample_format = SampleFormat::Float32;
+    std::string channel_layout;  // Per-channel metadata file (see ChannelLayout); empty = Ch1, Ch2, ...
     int device_param = 0;  // Device-specific parameter
+
+    // Synthetic signal (MockDevice): comma-separated lists, one entry per
+    // channel, the last entry repeating. An empty waveform keeps the counter.
+    std::string waveform;
+    std::string amplitude;
+    std::string frequency;
+    std::string phase;
+    std::string chirp_end;     // Chirp end frequencies
+    double chirp_period = 1.0; // Seconds per chirp sweep
+    uint64_t seed = 1;         // Pink noise seed
+    bool device_clock = false;     // Stamp chunks from a simulated hardware clock
+    double clock_drift_ppm = 0.0;  // Rate error of that clock
+
+    // Replay a recording or CSV file instead of the mock device
+    std::string replay;        // Path (empty = mock device)
+    double replay_speed = 1.0; // Playback speed factor; 0 = as fast as possible
+    bool replay_loop = false;
+
+    // Reconnect with exponential backoff after device read errors, keeping
+    // the outlet up (single-stream mode)
+    bool reconnect = false;
+    double reconnect_delay = 0.05;     // Seconds before the first attempt; doubles after each
+    double reconnect_max_delay = 2.0;  // Longest wait between attempts
+    double reconnect_timeout = 0.0;    // Give up after this many seconds; 0 = never
+
+    // Report device stalls and rates off nominal (see RateMonitor)
+    double rate_window = 10.0;    // Seconds the delivered rate is measured over
+    double rate_tolerance = 0.05; // Fraction off nominal that is reported; 0 = off
+    double stall_factor = 5.0;    // Gap in chunk periods reported as a stall; 0 = off
+
+    // Biquads applied before publishing, e.g. "highpass:0.5,notch:50,lowpass:40"
+    // (see parseFilters()); empty = unfiltered
+    std::string filters;
+    // Extra outlets at sample_rate / factor, e.g. "10,100" (see parseDecimation())
+    std::string decimate;
+    // Channel subsets published as extra streams, one [Split.N] section each
+    // (keys name, type, channels, labels)
+    std::vector<ChannelSplit> splits;
+
+    // Pipeline
+    double chunk_duration = 0.1;  // Seconds per device read and outlet chunk
+    int max_buffered = 360;       // Outlet buffer in seconds
+    bool adaptive_chunk = false;  // Resize chunks to meet latency_target within cpu_budget
+    double latency_target = 0.02; // Seconds
+    double cpu_budget = 0.01;     // Fraction of real time spent pushing
+    bool decoupled = false;  // Publish from a separate thread via a chunk ring
+    int ring_capacity = 32;  // Chunks buffered between acquisition and publishing
+    OverflowPolicy overflow_policy = OverflowPolicy::Block;
+    bool dejitter = false;   // Stamp samples from an online device-to-LSL clock fit
+    bool pace = false;       // Release chunks at the nominal rate (software-timed devices)
+    int pacing_spin_us = 0;  // Busy-wait before pacing deadlines for sub-ms accuracy
+    bool gate_on_consumers = false;  // Hold data back until an inlet connects
+    double preroll = 2.0;    // Seconds kept and flushed to the first inlet when gating
+    std::string record;      // Local recording base path (empty = off)
+    int record_segment_mb = 64;  // Preallocated size of each recording segment
+    double stats_interval = 0.0; // Seconds between statistics reports (CLI); 0 = off
+
+    // Real-time operation; the publisher settings apply when decoupled, the
+    // acquisition settings also to StreamManager workers
+    ThreadScheduling acquisition_scheduling;
+    ThreadScheduling publisher_scheduling;
+    bool lock_memory = false;  // mlockall() and pre-faulted stacks
+
+    bool operator==(const AppConfig&) const = default;
 };
 
 /**
@@ -32,10 +104,30 @@ class ConfigManager {
 public:
     /**
      * @brief Load configuration from file
+     * A value that does not parse rejects the whole file.
+     *
      * @param path Path to config file
+     * @param error Receives what went wrong, e.g. the key that did not parse
      * @return Loaded config, or nullopt on error
      */
-    static std::optional<AppConfig> load(const std::filesystem::path& path);
+    static std::optional<AppConfig> load(const std::filesystem::path& path,
+                                         std::string* error = nullptr);
+
+    /**
+     * @brief Load one configuration per stream
+     *
+     * Numbered sections such as [Stream.1] and [Device.1] describe stream 1;
+     * each stream starts from the unnumbered sections and overrides the keys
+     * it sets. Streams are returned in index order. A file without numbered
+     * sections yields a single configuration, the same as load(). [Split.N]
+     * sections are channel splits, not streams.
+     *
+     * @param path Path to config file
+     * @param error Receives what went wrong, as for load()
+     * @return Loaded configs, or nullopt on error
+     */
+    static std::optional<std::vector<AppConfig>> loadAll(const std::filesystem::path& path,
+                                                         std::string* error = nullptr);
 
     /**
      * @brief Save configuration to file
@@ -0,0 +1,80 @@
+#pragma once
+/**
+ * @file ConfigWatcher.hpp
+ * @brief Change notification for the configuration file
+ *
+ * Lets the applications pick up edits to LSLTemplate.cfg while streaming:
+ * settings that leave the stream unchanged are applied in place (see
+ * StreamThread::update()), everything else rebuilds the outlet.
+ */
+
+#include "Device.hpp"
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <thread>
+
+namespace lsltemplate {
+
+/**
+ * @brief Watches one file and reports when its content may have changed
+ *
+ * On Linux the file's directory is watched with inotify, which also sees
+ * editors that save by writing a new file and renaming it over the old
+ * one. Elsewhere, or if inotify is unavailable, the modification time and
+ * size are polled. Bursts of events are coalesced: the callback runs once
+ * the file has been quiet for `settle`.
+ */
+class ConfigWatcher {
+public:
+    using ChangeCallback = std::function<void()>;
+
+    struct Config {
+        std::chrono::milliseconds settle{200};          ///< Quiet time before reporting
+        std::chrono::milliseconds poll_interval{500};   ///< Polling fallback only
+        bool force_polling = false;
+    };
+
+    /**
+     * @param path File to watch (need not exist yet)
+     * @param on_change Called on the watcher thread after each change
+     * @param callback Optional status callback
+     */
+    ConfigWatcher(const std::filesystem::path& path, ChangeCallback on_change,
+                  StatusCallback callback = nullptr);
+    ConfigWatcher(const std::filesystem::path& path, const Config& config,
+                  ChangeCallback on_change, StatusCallback callback = nullptr);
+    ~ConfigWatcher();
+
+    ConfigWatcher(const ConfigWatcher&) = delete;
+    ConfigWatcher& operator=(const ConfigWatcher&) = delete;
+
+    /// Start watching; false if already running
+    bool start();
+
+    /// Stop watching and join the thread
+    void stop();
+
+    bool isRunning() const { return thread_.joinable(); }
+
+    const std::filesystem::path& path() const { return path_; }
+
+    /// "inotify" or "polling" (valid after start())
+    const char* backend() const { return inotify_fd_ >= 0 ? "inotify" : "polling"; }
+
+private:
+    void watchInotify();
+    void watchPolling();
+
+    std::filesystem::path path_;
+    Config config_;
+    ChangeCallback on_change_;
+    StatusCallback statusCallback_;
+
+    int inotify_fd_ = -1;
+    std::thread thread_;
+    std::atomic<bool> shutdown_{false};
+};
+
+} // namespace lsltemplate
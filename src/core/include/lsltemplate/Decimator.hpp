@@ -0,0 +1,149 @@
+#pragma once
+/**
+ * @file Decimator.hpp
+ * @brief Anti-aliased sample-rate reduction for derived outlets
+ *
+ * StreamThread can publish lower-rate copies of a stream next to the raw
+ * one (e.g. 10 kHz plus 1 kHz and 100 Hz) for dashboards and trend
+ * loggers. Each copy is produced by a linear-phase FIR decimator.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace lsltemplate {
+
+/**
+ * @brief Low-pass prototype for decimation by `factor`
+ *
+ * Blackman-windowed sinc with the cutoff at the output Nyquist frequency
+ * and a transition band of +-20% of it: everything above 1.2x the output
+ * Nyquist is attenuated by about 75 dB, so aliases only land in the top
+ * 20% of the output band. Length grows linearly with the factor (about
+ * 28 taps per unit); the taps sum to 1.
+ */
+std::vector<double> designDecimationFilter(std::size_t factor);
+
+/// Parse a factor list such as "10,100"; every factor must be at least 2
+std::optional<std::vector<std::size_t>> parseDecimation(std::string_view list);
+
+/// Inverse of parseDecimation()
+std::string formatDecimation(const std::vector<std::size_t>& factors);
+
+/**
+ * @brief Type-erased base of Decimator
+ */
+class DecimatorBase {
+public:
+    virtual ~DecimatorBase() = default;
+
+    std::size_t factor() const { return factor_; }
+    std::size_t taps() const { return taps_; }
+
+    /// Group delay in input samples; outputs describe the input this far back
+    double delay() const { return static_cast<double>(taps_ - 1) / 2.0; }
+
+    /// Outputs of the last process() call
+    std::size_t outputs() const { return outputs_; }
+
+    /// Input index (within the last process() call) each output is aligned with
+    const std::vector<std::size_t>& positions() const { return positions_; }
+
+protected:
+    DecimatorBase(std::size_t factor, std::size_t taps) : factor_(factor), taps_(taps) {}
+
+    std::size_t factor_;
+    std::size_t taps_;
+    std::size_t outputs_ = 0;
+    std::vector<std::size_t> positions_;
+};
+
+/**
+ * @brief FIR decimator over channel-interleaved samples
+ *
+ * Only every factor-th output of the anti-aliasing filter is computed,
+ * which is the arithmetic of a polyphase decimator: each input sample is
+ * multiplied by taps/factor coefficients on average. Filter history is
+ * kept per channel, so chunks may have any size; channels are the inner
+ * loop so the compiler vectorizes across them.
+ */
+template <typename T>
+class Decimator : public DecimatorBase {
+public:
+    Decimator(std::size_t factor, std::size_t channels)
+        : Decimator(factor, channels, designDecimationFilter(factor))
+    {
+    }
+
+    /**
+     * @brief Decimate the next input samples
+     *
+     * Outputs are available from output() until the next call.
+     *
+     * @param data Channel-interleaved input
+     * @param samples Number of input samples
+     * @return Number of output samples
+     */
+    std::size_t process(const T* data, std::size_t samples) {
+        const std::size_t history = taps_ - 1;
+        work_.resize((history + samples) * channels_);
+        std::copy(history_.begin(), history_.end(), work_.begin());
+        std::copy_n(data, samples * channels_, work_.begin() + history * channels_);
+
+        outputs_ = 0;
+        output_.resize((samples / factor_ + 1) * channels_);
+        positions_.resize(samples / factor_ + 1);
+        std::size_t i = next_;
+        for (; i < samples; i += factor_) {
+            // Window of taps inputs ending at input i (newest first)
+            const T* newest = work_.data() + (history + i) * channels_;
+            T* out = output_.data() + outputs_ * channels_;
+            std::fill_n(out, channels_, T{});
+            for (std::size_t k = 0; k < taps_; ++k) {
+                const T h = coefficients_[k];
+                const T* in = newest - k * channels_;
+                for (std::size_t c = 0; c < channels_; ++c) {
+                    out[c] += h * in[c];
+                }
+            }
+            positions_[outputs_++] = i;
+        }
+        next_ = i - samples;
+
+        std::copy(work_.end() - static_cast<std::ptrdiff_t>(history * channels_), work_.end(),
+                  history_.begin());
+        return outputs_;
+    }
+
+    /// Channel-interleaved outputs of the last process() call
+    const T* output() const { return output_.data(); }
+
+    /// Clear the filter history (as after construction)
+    void reset() {
+        std::fill(history_.begin(), history_.end(), T{});
+        next_ = 0;
+        outputs_ = 0;
+    }
+
+private:
+    Decimator(std::size_t factor, std::size_t channels, const std::vector<double>& design)
+        : DecimatorBase(factor, design.size())
+        , channels_(std::max<std::size_t>(1, channels))
+        , coefficients_(design.begin(), design.end())
+        , history_((design.size() - 1) * channels_)
+    {
+    }
+
+    std::size_t channels_;
+    std::vector<T> coefficients_;
+    std::vector<T> history_;  // Last taps - 1 inputs
+    std::vector<T> work_;     // History followed by the current chunk
+    std::vector<T> output_;
+    std::size_t next_ = 0;    // Input index of the next output in the next chunk
+};
+
+} // namespace lsltemplate
@@ -7,13 +7,35 @@
  * Replace the MockDevice implementation with your actual device SDK integration.
  */
 
+#include "ChannelLayout.hpp"
+#include "Pacer.hpp"
+#include "SampleFormat.hpp"
+#include "SignalGenerator.hpp"
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
+#include <span>
+#include <stop_token>
 #include <string>
 #include <vector>
 
 namespace lsltemplate {
 
+/**
+ * @brief Status callback type
+ */
+using StatusCallback = std::function<void(const std::string& message, bool is_error)>;
+
+/**
+ * @brief Clock domain of the timestamps a device reports from getData()
+ */
+enum class TimestampClock {
+    Lsl,     ///< lsl::local_clock() seconds; pushed as-is unless dejittering
+    Device   ///< Hardware clock or sequence time in seconds; mapped to LSL time
+};
+
 /**
  * @brief Device information structure
  */
@@ -23,6 +45,9 @@ struct DeviceInfo {
     int channel_count = 1;      ///< Number of channels
     double sample_rate = 0.0;   ///< Nominal sample rate (0 for irregular)
     std::string source_id;      ///< Unique source identifier
+    SampleFormat format = SampleFormat::Float32;  ///< Native sample type
+    TimestampClock timestamp_clock = TimestampClock::Lsl;  ///< Domain of getData() timestamps
+    std::vector<ChannelDescription> channel_layout;  ///< Per-channel metadata; empty = defaults
 };
 
 /**
@@ -34,9 +59,30 @@ struct DeviceInfo {
  *   - disconnect() - Clean up hardware connection
  *   - getData()    - Retrieve samples from the device
  *   - getInfo()    - Return device metadata for LSL stream creation
+ *
+ * getData() is overloaded for every LSL channel format. Override the span
+ * overload matching DeviceInfo::format; the samples are pushed to the outlet
+ * as-is, without conversion. The other overloads fail by default.
+ *
+ * Devices written against the older `bool getData(std::vector<T>&)` contract
+ * keep working: the default span overloads adapt them, at the cost of one
+ * copy per chunk.
+ *
+ * How long stopping a stream takes is bounded by how quickly a blocking
+ * getData() returns. Wait with sleepUntil(deadline, stopToken()), or
+ * register a std::stop_callback on stopToken() that aborts the SDK call,
+ * so that getData() returns as soon as the stream is stopped.
  */
 class IDevice {
 public:
+    /// Returned by getData(std::span<T>, double&) on error or shutdown
+    static constexpr std::size_t kReadError = static_cast<std::size_t>(-1);
+
+    /// Returned by getData(std::span<T>, double&) once a finite source,
+    /// such as a recording, has delivered everything; the stream ends
+    /// without an error and without reconnecting
+    static constexpr std::size_t kEndOfData = static_cast<std::size_t>(-2);
+
     virtual ~IDevice() = default;
 
     /// Connect to the device. Returns true on success.
@@ -51,15 +97,65 @@ public:
     /// Get device information for LSL stream setup
     virtual DeviceInfo getInfo() const = 0;
 
+    /// Set by the streaming thread before its first getData() call
+    void setStopToken(std::stop_token token) { stop_token_ = std::move(token); }
+
+    /// Requested when the stream is stopping; see the class description
+    const std::stop_token& stopToken() const { return stop_token_; }
+
+    /**
+     * @brief Read whatever samples are ready, up to the size of the span
+     * @param out Destination for channel-interleaved samples; its size is a
+     *            multiple of the channel count
+     * @param timestamp Initialised to 0.0 by the caller. Set it to the
+     *            capture time of the last sample written, in the clock domain
+     *            given by DeviceInfo::timestamp_clock, or leave it at 0.0 to
+     *            have the chunk stamped on arrival.
+     * @return Number of samples (not values) written, 0 if nothing was ready,
+     *         kReadError on error or shutdown, or kEndOfData when the source
+     *         is exhausted
+     *
+     * Return as soon as some data is available rather than waiting for the
+     * span to fill up; only the samples written are pushed. When nothing is
+     * ready, wait up to roughly one chunk period before returning 0.
+     */
+    virtual std::size_t getData(std::span<float> out, double& timestamp);
+    virtual std::size_t getData(std::span<double> out, double& timestamp);
+    virtual std::size_t getData(std::span<int64_t> out, double& timestamp);
+    virtual std::size_t getData(std::span<int32_t> out, double& timestamp);
+    virtual std::size_t getData(std::span<int16_t> out, double& timestamp);
+    virtual std::size_t getData(std::span<int8_t> out, double& timestamp);
+    virtual std::size_t getData(std::span<std::string> out, double& timestamp);
+
     /**
-     * @brief Retrieve data from the device
+     * @brief Retrieve data from the device (legacy whole-buffer contract)
      * @param buffer Output buffer to fill with samples (channel-interleaved)
      * @return true if data was retrieved successfully, false on error or shutdown
      *
      * This method should block until data is available or an error occurs.
      * The buffer size determines how many samples to retrieve.
      */
-    virtual bool getData(std::vector<float>& buffer) = 0;
+    virtual bool getData(std::vector<float>& buffer);
+    virtual bool getData(std::vector<double>& buffer);
+    virtual bool getData(std::vector<int64_t>& buffer);
+    virtual bool getData(std::vector<int32_t>& buffer);
+    virtual bool getData(std::vector<int16_t>& buffer);
+    virtual bool getData(std::vector<int8_t>& buffer);
+    virtual bool getData(std::vector<std::string>& buffer);
+
+    /**
+     * @brief Apply a new AppConfig::device_param while streaming
+     * @return false if the device must be reconnected for it to take effect
+     *
+     * Called on the acquisition thread between two getData() calls.
+     */
+    virtual bool setParameter(int value) { (void)value; return false; }
+
+private:
+    template <typename T>
+    std::size_t readLegacy(std::span<T> out);
+
+    std::stop_token stop_token_;
 };
 
 /**
@@ -76,6 +172,22 @@ public:
         int channel_count = 1;
         double sample_rate = 10.0;  // 10 Hz
         int32_t start_value = 0;
+        SampleFormat format = SampleFormat::Float32;
+        bool device_clock = false;     // Report timestamps from a simulated hardware clock
+        double clock_drift_ppm = 0.0;  // Rate error of that clock
+
+        // Synthetic waveforms per channel (last entry repeats). Empty keeps
+        // the plain value counter.
+        std::vector<ChannelSignal> signals;
+        double chirp_period = 1.0;  // Seconds per chirp sweep
+        uint64_t seed = 1;          // Pink noise seed
+
+        // Busy-wait this long before each chunk deadline (sub-ms pacing)
+        std::chrono::microseconds pacing_spin{0};
+
+        // false: getData() returns at once with only the samples due by
+        // now (possibly none), for polling from a StreamManager
+        bool blocking = true;
     };
 
     explicit MockDevice(const Config& config);
@@ -85,12 +197,33 @@ public:
     void disconnect() override;
     bool isConnected() const override;
     DeviceInfo getInfo() const override;
-    bool getData(std::vector<float>& buffer) override;
+
+    /// Synthetic signal engine, or nullptr when generating the plain counter
+    const SignalGenerator* getGenerator() const { return generator_.get(); }
+
+    using IDevice::getData;
+    std::size_t getData(std::span<float> out, double& timestamp) override;
+    std::size_t getData(std::span<double> out, double& timestamp) override;
+    std::size_t getData(std::span<int64_t> out, double& timestamp) override;
+    std::size_t getData(std::span<int32_t> out, double& timestamp) override;
+    std::size_t getData(std::span<int16_t> out, double& timestamp) override;
+    std::size_t getData(std::span<int8_t> out, double& timestamp) override;
+    std::size_t getData(std::span<std::string> out, double& timestamp) override;
+
+    /// Restarts the counter at the new start value
+    bool setParameter(int value) override;
 
 private:
+    template <typename T>
+    std::size_t generate(std::span<T> out, double& timestamp);
+
     Config config_;
     bool connected_ = false;
     int32_t counter_ = 0;
+    uint64_t samples_generated_ = 0;
+    std::unique_ptr<SignalGenerator> generator_;
+    std::vector<float> scratch_;  // Generator output for non-float formats
+    Pacer pacer_;                 // Releases chunks at the nominal rate
 };
 
 } // namespace lsltemplate
@@ -0,0 +1,128 @@
+#pragma once
+/**
+ * @file FileReplayDevice.hpp
+ * @brief Device that plays back a recorded stream
+ *
+ * Feeds recorded data through the normal streaming path for regression and
+ * load tests: segment files written by Recorder, or CSV files with one row
+ * per sample (timestamp first, then one column per channel).
+ */
+
+#include "Device.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace lsltemplate {
+
+class MappedFile;
+
+/**
+ * @brief Replays a recording with its original timing, scaled by a speed factor
+ *
+ * The file is memory-mapped and indexed when the device is constructed.
+ * Recorded chunks are released when they fall due, (recorded time since
+ * the first chunk) / speed after connect(); a speed of 0 releases them as
+ * fast as they are read. Timestamps are reported in device time
+ * (TimestampClock::Device), i.e. scaled replay time, so StreamThread maps
+ * them onto the LSL clock; at unlimited speed chunks are stamped on arrival.
+ *
+ * At the end of the file getData() returns kEndOfData, ending the stream
+ * cleanly, unless looping.
+ */
+class FileReplayDevice : public IDevice {
+public:
+    struct Config {
+        /// Recorder segment (following _NNNN segments are replayed too) or
+        /// a .csv file
+        std::filesystem::path path;
+        double speed = 1.0;  ///< Playback speed factor; 0 = as fast as possible
+        bool loop = false;   ///< Start over at the end of the recording
+
+        std::string type = "Replay";
+
+        // CSV only: the segment header provides these for recordings
+        std::string name = "Replay";
+        SampleFormat format = SampleFormat::Double64;  ///< String keeps the cell text
+        double sample_rate = 0.0;  ///< 0 = estimate from the timestamps
+
+        /// false: getData() returns at once with only the samples due by
+        /// now (possibly none), for polling from a StreamManager
+        bool blocking = true;
+    };
+
+    explicit FileReplayDevice(const Config& config);
+    ~FileReplayDevice() override;
+
+    /// Whether the file was loaded; see error() otherwise
+    bool isValid() const { return error_.empty(); }
+    const std::string& error() const { return error_; }
+
+    /// Samples in one pass over the recording
+    uint64_t sampleCount() const { return total_samples_; }
+
+    /// Recorded duration of one pass in seconds
+    double duration() const { return period_; }
+
+    bool connect() override;
+    void disconnect() override;
+    bool isConnected() const override;
+    DeviceInfo getInfo() const override;
+
+    using IDevice::getData;
+    std::size_t getData(std::span<float> out, double& timestamp) override;
+    std::size_t getData(std::span<double> out, double& timestamp) override;
+    std::size_t getData(std::span<int64_t> out, double& timestamp) override;
+    std::size_t getData(std::span<int32_t> out, double& timestamp) override;
+    std::size_t getData(std::span<int16_t> out, double& timestamp) override;
+    std::size_t getData(std::span<int8_t> out, double& timestamp) override;
+    std::size_t getData(std::span<std::string> out, double& timestamp) override;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // A recorded chunk (one row for CSV)
+    struct Block {
+        uint64_t first = 0;           // Index of its first sample
+        std::size_t samples = 0;
+        double timestamp = 0.0;       // Recorded time of the last sample
+        double sample_interval = 0.0;
+        const std::byte* data = nullptr;  // Fixed-size values in the mapping
+    };
+
+    bool loadRecording();
+    bool loadCsv();
+    bool fail(const std::string& message);
+    void finishIndex();
+
+    Clock::time_point due(std::size_t block, uint64_t loop) const;
+
+    template <typename T>
+    std::size_t replay(std::span<T> out, double& timestamp);
+    template <typename T>
+    void copySamples(const Block& block, std::size_t offset, std::size_t samples, T* out) const;
+
+    Config config_;
+    DeviceInfo info_;
+    std::string error_;
+
+    std::vector<std::unique_ptr<MappedFile>> files_;
+    std::vector<Block> blocks_;
+    std::vector<double> csv_values_;      // CSV samples, channel-interleaved
+    std::vector<std::string> strings_;    // String recordings, decoded
+    uint64_t total_samples_ = 0;
+    double period_ = 0.0;  // Recorded seconds from one pass to the next
+
+    // Playback position
+    bool connected_ = false;
+    Clock::time_point start_;
+    std::size_t block_ = 0;
+    std::size_t offset_ = 0;  // Samples of the current block already read
+    uint64_t loop_ = 0;
+};
+
+} // namespace lsltemplate
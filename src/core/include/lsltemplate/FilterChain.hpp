@@ -0,0 +1,120 @@
+#pragma once
+/**
+ * @file FilterChain.hpp
+ * @brief In-line IIR filtering of the published samples
+ *
+ * Applies a cascade of biquads (notch, high-pass, low-pass, band-pass) to
+ * each chunk between the device read and the outlet, so mains hum and
+ * drift are removed at the source instead of in every consumer.
+ */
+
+#include "SampleFormat.hpp"
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace lsltemplate {
+
+namespace simd {
+struct FilterKernels;
+struct BiquadCoefficients;
+}
+
+enum class FilterType {
+    LowPass,
+    HighPass,
+    BandPass,  ///< Resonant band-pass around frequency, 0 dB at the peak
+    Notch
+};
+
+/// Parse "lowpass", "highpass", "bandpass" or "notch"
+std::optional<FilterType> parseFilterType(std::string_view name);
+
+/// Config-file spelling of a filter type
+const char* toString(FilterType type);
+
+/**
+ * @brief One second-order section (RBJ cookbook design)
+ */
+struct FilterSpec {
+    FilterType type = FilterType::Notch;
+    double frequency = 50.0;  ///< Cutoff or centre frequency in Hz
+    double q = 0.0;           ///< Quality factor; 0 = 1/sqrt(2) (Butterworth), 30 for notches
+
+    bool operator==(const FilterSpec&) const = default;
+};
+
+/**
+ * @brief Parse a filter list such as "highpass:0.5, notch:50, lowpass:40"
+ *
+ * Entries are TYPE:FREQUENCY[:Q], applied in order. "bandpass:LOW-HIGH"
+ * is shorthand for a Butterworth high-pass at LOW followed by a low-pass
+ * at HIGH, the usual way to band-limit broadband signals; "bandpass:F[:Q]"
+ * is a single resonant section. An empty string is no filtering.
+ *
+ * @return Filter stages, or nullopt if any entry fails to parse
+ */
+std::optional<std::vector<FilterSpec>> parseFilters(std::string_view list);
+
+/// Inverse of parseFilters()
+std::string formatFilters(const std::vector<FilterSpec>& filters);
+
+/**
+ * @brief Per-channel cascade of biquads over channel-interleaved chunks
+ *
+ * Every channel runs the same stages with its own state, carried from one
+ * chunk to the next. Float32 streams are filtered a SIMD register of
+ * channels at a time (AVX2 or NEON, chosen at runtime, with a scalar
+ * fallback); coefficients are designed in double precision. Double64
+ * streams are filtered in double precision. Other formats are rejected.
+ */
+class FilterChain {
+public:
+    /**
+     * @param filters Stages, applied in order
+     * @param format Sample format of the stream
+     * @param sample_rate Nominal rate in Hz (must be regular)
+     * @param channels Channels per sample
+     */
+    FilterChain(const std::vector<FilterSpec>& filters, SampleFormat format,
+                double sample_rate, std::size_t channels);
+    ~FilterChain();
+
+    /// Whether the filters could be designed; see error() otherwise
+    bool isValid() const { return error_.empty(); }
+    const std::string& error() const { return error_; }
+
+    /// Number of biquad sections
+    std::size_t stages() const { return stages_.size(); }
+
+    /// Filter `samples` channel-interleaved samples in place
+    void process(float* data, std::size_t samples);
+    void process(double* data, std::size_t samples);
+
+    /// Clear the filter state (as after construction)
+    void reset();
+
+    /// Instruction set in use ("avx2", "neon", "scalar"; "double" for Double64)
+    const char* isa() const;
+
+private:
+    std::string error_;
+    std::size_t channels_ = 1;
+    const simd::FilterKernels* kernels_ = nullptr;
+
+    // Double-precision designs, applied as-is to Double64 streams
+    struct Section {
+        double b0, b1, b2, a1, a2;
+    };
+    std::vector<Section> stages_;
+    bool double_ = false;
+
+    // State, stage * channels + channel
+    std::vector<simd::BiquadCoefficients> coefficients_;
+    std::vector<float> z1_, z2_;
+    std::vector<double> z1d_, z2d_;
+};
+
+} // namespace lsltemplate
@@ -9,11 +9,26 @@
 #include "Device.hpp"
 #include <lsl_cpp.h>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
 namespace lsltemplate {
 
+/**
+ * @brief Stream description for `info`, including per-channel metadata
+ *
+ * The channel format follows the device's native sample type; labels,
+ * units, types and locations come from DeviceInfo::channel_layout. Large
+ * layouts (from a few hundred channels) are serialized to XML in a single
+ * pass and parsed by liblsl in one call, instead of being appended one
+ * element per call; liblsl versions that reject the document fall back to
+ * the element API.
+ *
+ * @param bulk Force the XML (true) or element (false) path
+ */
+lsl::stream_info makeStreamInfo(const DeviceInfo& info, std::optional<bool> bulk = std::nullopt);
+
 /**
  * @brief Wrapper for LSL stream outlet
  *
@@ -25,8 +40,12 @@ public:
     /**
      * @brief Construct an outlet for the given device
      * @param info Device information for stream setup
+     * @param chunk_size Preferred samples per network transmission
+     *                   (0 = as pushed)
+     * @param max_buffered Maximum data buffered for a slow consumer, in
+     *                     seconds (hundreds of samples for irregular streams)
      */
-    explicit LSLOutlet(const DeviceInfo& info);
+    explicit LSLOutlet(const DeviceInfo& info, int chunk_size = 0, int max_buffered = 360);
 
     ~LSLOutlet();
 
@@ -41,14 +60,54 @@ public:
     /**
      * @brief Push a chunk of samples to the outlet
      * @param data Channel-interleaved sample data
+     *
+     * T should match DeviceInfo::format; liblsl converts otherwise.
      */
-    void pushChunk(const std::vector<float>& data);
+    template <typename T>
+    void pushChunk(const std::vector<T>& data) {
+        pushChunk(data.data(), data.size());
+    }
+
+    /**
+     * @brief Push a chunk of samples from a raw buffer
+     * @param data Channel-interleaved sample data
+     * @param elements Number of values (samples * channels)
+     * @param timestamp lsl::local_clock() time of the last sample, or 0.0
+     *                  to stamp the chunk at push time
+     */
+    template <typename T>
+    void pushChunk(const T* data, std::size_t elements, double timestamp = 0.0) {
+        static_assert(is_sample_type_v<T>, "Unsupported sample type");
+        if (outlet_ && elements > 0) {
+            outlet_->push_chunk_multiplexed(lslPointer(data), elements, timestamp);
+        }
+    }
+
+    /**
+     * @brief Push a chunk with one timestamp per sample
+     * @param data Channel-interleaved sample data
+     * @param timestamps lsl::local_clock() time of each sample
+     * @param elements Number of values (samples * channels)
+     */
+    template <typename T>
+    void pushChunk(const T* data, const double* timestamps, std::size_t elements) {
+        static_assert(is_sample_type_v<T>, "Unsupported sample type");
+        if (outlet_ && elements > 0) {
+            outlet_->push_chunk_multiplexed(lslPointer(data), timestamps, elements);
+        }
+    }
 
     /**
      * @brief Push a single sample to the outlet
      * @param sample Single sample (one value per channel)
      */
-    void pushSample(const std::vector<float>& sample);
+    template <typename T>
+    void pushSample(const std::vector<T>& sample) {
+        static_assert(is_sample_type_v<T>, "Unsupported sample type");
+        if (outlet_ && !sample.empty()) {
+            outlet_->push_sample(lslPointer(sample.data()));
+        }
+    }
 
     /// Get the stream name
     std::string getStreamName() const;
@@ -56,7 +115,20 @@ public:
     /// Check if outlet has consumers
     bool hasConsumers() const;
 
+    /// Channel format of the stream
+    SampleFormat getFormat() const;
+
 private:
+    // liblsl takes int8 samples as char
+    template <typename T>
+    static const auto* lslPointer(const T* data) {
+        if constexpr (std::is_same_v<T, int8_t>) {
+            return reinterpret_cast<const char*>(data);
+        } else {
+            return data;
+        }
+    }
+
     std::unique_ptr<lsl::stream_outlet> outlet_;
     DeviceInfo info_;
 };
@@ -0,0 +1,93 @@
+#pragma once
+/**
+ * @file Pacer.hpp
+ * @brief Drift-free real-time pacing against absolute deadlines
+ *
+ * Software-timed sources (simulated devices, devices without a hardware
+ * clock) must release samples at their nominal rate. Sleeping for a
+ * relative period after each chunk accumulates rounding and scheduling
+ * error; the Pacer instead derives every deadline from a fixed start time
+ * and the total sample count, so errors never accumulate.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <stop_token>
+
+namespace lsltemplate {
+
+/**
+ * @brief Sleep until deadline, or until stop is requested
+ * @return false if woken by the stop request
+ *
+ * Wakes within microseconds of request_stop() on the token's source.
+ * Does not allocate; a token without a source sleeps uninterrupted.
+ */
+bool sleepUntil(std::chrono::steady_clock::time_point deadline, const std::stop_token& stop);
+
+/**
+ * @brief Schedules sample releases at a nominal rate
+ *
+ * Deadline of sample n is start + n / rate. wait() sleeps until the
+ * deadline of the last sample in the chunk; optionally the final stretch
+ * is spun instead of slept for sub-millisecond accuracy. Not thread-safe.
+ */
+class Pacer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Config {
+        double rate = 0.0;  ///< Nominal samples per second; 0 disables waiting
+
+        /// Busy-wait this long before each deadline instead of sleeping
+        /// (0 = sleep only; ~1 ms gives sub-millisecond release accuracy)
+        std::chrono::microseconds spin{0};
+
+        /// Restart the schedule when this far behind (e.g. after the
+        /// process was suspended) instead of releasing a catch-up burst
+        std::chrono::milliseconds max_lag{1000};
+    };
+
+    explicit Pacer(const Config& config);
+
+    /// Restart the schedule from now
+    void reset();
+
+    /**
+     * @brief Account for samples and wait until they are due
+     * @param samples Samples released by this call
+     * @param stop Returns early when stop is requested
+     */
+    void wait(uint64_t samples, const std::stop_token& stop = {});
+
+    /// Account for samples without waiting (sources that are polled)
+    void advance(uint64_t samples);
+
+    /// Samples that are due by now but have not been released yet
+    uint64_t available() const;
+
+    /// Nominal rate
+    double nominalRate() const { return config_.rate; }
+
+    /// Samples per second actually released, from reset() to the latest wait()
+    double achievedRate() const;
+
+    /// Samples released since reset()
+    uint64_t samples() const { return samples_; }
+
+    /// Times the schedule was restarted because it fell too far behind
+    uint64_t resyncs() const { return resyncs_; }
+
+private:
+    Clock::time_point deadline() const;
+
+    Config config_;
+    Clock::time_point start_;
+    uint64_t samples_ = 0;       // Released since reset()
+    uint64_t base_samples_ = 0;  // Samples already due at start_
+    uint64_t resyncs_ = 0;
+    Clock::time_point reset_time_;
+    Clock::time_point last_release_;
+};
+
+} // namespace lsltemplate
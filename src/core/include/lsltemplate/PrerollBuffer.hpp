@@ -0,0 +1,141 @@
+#pragma once
+/**
+ * @file PrerollBuffer.hpp
+ * @brief Bounded history of recent samples kept while an outlet is unused
+ *
+ * With consumer gating, chunks are not pushed into liblsl while nobody is
+ * subscribed. The most recent samples are kept here instead, each with its
+ * own timestamp, and handed to the outlet once the first inlet connects.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace lsltemplate {
+
+/// Samples in `seconds` of a stream; irregular streams count 100 per second,
+/// as liblsl does for max_buffered
+inline std::size_t prerollCapacity(double sample_rate, double seconds) {
+    const double rate = sample_rate > 0 ? sample_rate : 100.0;
+    return seconds > 0 ? static_cast<std::size_t>(std::ceil(seconds * rate)) : 0;
+}
+
+/**
+ * @brief Type-independent part of PrerollBuffer: ring positions
+ */
+class PrerollBufferBase {
+public:
+    PrerollBufferBase(const PrerollBufferBase&) = delete;
+    PrerollBufferBase& operator=(const PrerollBufferBase&) = delete;
+    virtual ~PrerollBufferBase() = default;
+
+    /// Samples currently held
+    std::size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+
+    /// Maximum samples held; older ones are discarded first
+    std::size_t capacity() const { return capacity_; }
+
+    void clear() {
+        head_ = 0;
+        count_ = 0;
+    }
+
+protected:
+    PrerollBufferBase(std::size_t capacity, std::size_t channels)
+        : capacity_(capacity)
+        , channels_(std::max<std::size_t>(1, channels))
+    {
+    }
+
+    std::size_t capacity_;
+    std::size_t channels_;
+    std::size_t head_ = 0;   // Oldest sample
+    std::size_t count_ = 0;
+};
+
+/**
+ * @brief Fixed-capacity ring of channel-interleaved samples and timestamps
+ *
+ * All storage is allocated up front. Not thread-safe: owned by the thread
+ * that publishes to the outlet.
+ */
+template <typename T>
+class PrerollBuffer : public PrerollBufferBase {
+public:
+    /**
+     * @param capacity Samples to keep (0 discards everything)
+     * @param channels Values per sample
+     */
+    PrerollBuffer(std::size_t capacity, std::size_t channels)
+        : PrerollBufferBase(capacity, channels)
+        , data_(capacity * channels_)
+        , times_(capacity)
+    {
+    }
+
+    /**
+     * @brief Append a chunk, overwriting the oldest samples when full
+     * @param data Channel-interleaved samples
+     * @param samples Number of samples
+     * @param timestamp lsl::local_clock() time of the last sample
+     * @param sample_interval Spacing of the earlier samples' timestamps
+     * @return Samples discarded to make room
+     */
+    std::size_t append(const T* data, std::size_t samples, double timestamp, double sample_interval) {
+        if (capacity_ == 0) {
+            return samples;
+        }
+
+        std::size_t discarded = 0;
+        std::size_t first = 0;  // Index in the chunk of the first sample kept
+        if (samples > capacity_) {
+            first = samples - capacity_;
+            discarded += first;
+        }
+        const std::size_t kept = samples - first;
+        const std::size_t overflow = count_ + kept > capacity_ ? count_ + kept - capacity_ : 0;
+        head_ = (head_ + overflow) % capacity_;
+        count_ -= overflow;
+        discarded += overflow;
+
+        std::size_t tail = (head_ + count_) % capacity_;
+        for (std::size_t i = first; i < samples;) {
+            const std::size_t n = std::min(samples - i, capacity_ - tail);
+            std::copy_n(data + i * channels_, n * channels_, data_.begin() + tail * channels_);
+            for (std::size_t k = 0; k < n; ++k) {
+                times_[tail + k] = timestamp -
+                    static_cast<double>(samples - 1 - (i + k)) * sample_interval;
+            }
+            i += n;
+            count_ += n;
+            tail = (tail + n) % capacity_;
+        }
+        return discarded;
+    }
+
+    /**
+     * @brief Hand every held sample to push, oldest first, then clear
+     *
+     * push(const T* data, const double* timestamps, std::size_t samples) is
+     * called once, or twice when the held samples wrap around the ring.
+     */
+    template <typename Push>
+    void drain(Push&& push) {
+        while (count_ > 0) {
+            const std::size_t n = std::min(count_, capacity_ - head_);
+            push(data_.data() + head_ * channels_, times_.data() + head_, n);
+            head_ = (head_ + n) % capacity_;
+            count_ -= n;
+        }
+        head_ = 0;
+    }
+
+private:
+    std::vector<T> data_;
+    std::vector<double> times_;
+};
+
+} // namespace lsltemplate
@@ -0,0 +1,141 @@
+#pragma once
+/**
+ * @file PreviewBuffer.hpp
+ * @brief Min/max envelope of the recent signal for live display
+ *
+ * A local plot should not have to subscribe to the stream over the network.
+ * The publishing thread folds every chunk into a per-channel min/max envelope
+ * with a fixed number of columns; a display thread picks up the latest
+ * envelope without locks, and reduces it further to its own width.
+ */
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace lsltemplate {
+
+/**
+ * @brief One published envelope
+ *
+ * Channel ch of column c is at [c * channels + ch], columns oldest first;
+ * only the first `columns` are filled. The newest column may still be
+ * growing.
+ */
+struct PreviewFrame {
+    std::size_t channels = 0;
+    std::size_t capacity = 0;        ///< Columns allocated per channel
+    std::size_t columns = 0;         ///< Columns filled per channel
+    double column_duration = 0.0;    ///< Seconds per completed column
+    uint64_t samples = 0;            ///< Samples folded in so far
+    uint64_t sequence = 0;           ///< Publication number
+    std::vector<float> min;
+    std::vector<float> max;
+
+    float minAt(std::size_t channel, std::size_t column) const { return min[column * channels + channel]; }
+    float maxAt(std::size_t channel, std::size_t column) const { return max[column * channels + channel]; }
+};
+
+/**
+ * @brief Envelope builder and lock-free triple buffer of PreviewFrame
+ *
+ * write() runs on the publishing thread: it costs a compare per value,
+ * never allocates, locks or waits, and copies the envelope into a spare
+ * frame at most `refresh` times per second, and only once the reader took
+ * the previous one, so an unwatched preview costs next to nothing. latest()
+ * runs on a single reader thread and swaps in the newest frame, which then
+ * stays untouched by the writer until the next call. A reader polling less
+ * often than `refresh` gets frames about one polling period old.
+ */
+class PreviewBuffer {
+public:
+    struct Config {
+        std::size_t columns = 0;  ///< Envelope resolution; 0 disables the preview
+        double window = 5.0;      ///< Seconds shown (x100 samples if irregular)
+        double refresh = 30.0;    ///< Publications per second at most
+
+        bool operator==(const Config&) const = default;
+    };
+
+    /**
+     * @param config Envelope settings (columns is raised to at least 2)
+     * @param channels Values per sample
+     * @param sample_rate Nominal rate, 0 if irregular
+     */
+    PreviewBuffer(const Config& config, std::size_t channels, double sample_rate);
+
+    PreviewBuffer(const PreviewBuffer&) = delete;
+    PreviewBuffer& operator=(const PreviewBuffer&) = delete;
+
+    /// Fold channel-interleaved samples into the envelope (publishing thread)
+    template <typename T>
+    void write(const T* data, std::size_t samples) {
+        if constexpr (std::is_arithmetic_v<T>) {
+            for (std::size_t s = 0; s < samples; ++s, data += channels_) {
+                float* min = min_.data() + head_ * channels_;
+                float* max = max_.data() + head_ * channels_;
+                for (std::size_t ch = 0; ch < channels_; ++ch) {
+                    const float value = static_cast<float>(data[ch]);
+                    min[ch] = value < min[ch] ? value : min[ch];
+                    max[ch] = value > max[ch] ? value : max[ch];
+                }
+                if (++column_fill_ == samples_per_column_) {
+                    advance();
+                }
+            }
+            samples_ += samples;
+            since_publish_ += samples;
+            if (since_publish_ >= publish_every_) {
+                publish();
+            }
+        } else {
+            (void)data;
+            (void)samples;
+        }
+    }
+
+    /**
+     * @brief The newest published frame (reader thread)
+     * @return nullptr until the first publication; the same frame again if
+     *         nothing new was published since the last call
+     */
+    const PreviewFrame* latest();
+
+private:
+    void advance();
+    void publish();
+
+    static constexpr uint8_t kIndexMask = 0x3;
+    static constexpr uint8_t kFresh = 0x4;  // Middle frame not taken by the reader yet
+
+    std::size_t channels_;
+    std::size_t capacity_;
+    std::size_t samples_per_column_;
+    uint64_t publish_every_;
+    double column_duration_;
+
+    // Writer: envelope ring, [column * channels_ + channel]
+    std::vector<float> min_;
+    std::vector<float> max_;
+    std::size_t head_ = 0;         // Column being filled
+    std::size_t completed_ = 0;    // Columns completed, saturating at capacity_
+    std::size_t column_fill_ = 0;  // Samples in the head column
+    uint64_t samples_ = 0;
+    uint64_t since_publish_ = 0;
+    uint64_t sequence_ = 0;
+
+    // Triple buffer: the writer fills back_, the reader owns front_, and
+    // middle_ holds the third frame's index plus kFresh
+    std::array<PreviewFrame, 3> frames_;
+    uint8_t back_ = 0;
+    alignas(64) std::atomic<uint8_t> middle_{1};
+    uint8_t front_ = 2;
+    bool published_ = false;  // Reader: has taken a frame
+};
+
+} // namespace lsltemplate
@@ -0,0 +1,118 @@
+#pragma once
+/**
+ * @file RateMonitor.hpp
+ * @brief Online check of the rate a device actually delivers
+ *
+ * A device that drifts off its nominal rate or stalls now and then is
+ * otherwise only noticed when the recording is analysed. RateMonitor sees
+ * every chunk as it is read and flags both while streaming.
+ */
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace lsltemplate {
+
+/**
+ * @brief Stall and rate-deviation detector fed with every device read
+ *
+ * A stall is a gap between two chunks longer than `stall_factor` chunk
+ * periods. Every read is checked, empty ones included, so a device that
+ * keeps returning nothing is reported once when the gap crosses the limit,
+ * and again when data resumes; one that blocks inside its read can only be
+ * reported when that read returns. The effective rate is the number of samples delivered between
+ * two chunk arrivals about `window` seconds apart, divided by the time
+ * between them; it is re-evaluated every tenth of a window, which keeps the
+ * cost per chunk constant. A deviation is flagged once the rate is more
+ * than `tolerance` off nominal and cleared once it is back within half of
+ * that, so a rate hovering at the limit does not flap.
+ *
+ * Not thread-safe: owned by the acquisition thread.
+ */
+class RateMonitor {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Config {
+        double window = 10.0;       ///< Seconds the effective rate is measured over
+        double tolerance = 0.0;     ///< Flag rates off nominal by more than this fraction; 0 = off
+        double stall_factor = 0.0;  ///< Flag gaps longer than this many chunk periods; 0 = off
+
+        bool operator==(const Config&) const = default;
+    };
+
+    /// What onRead() noticed
+    enum class Event {
+        None,
+        Stall,           ///< No data for lastGap() seconds; reported once per stall
+        Resumed,         ///< Data is back after a reported stall of lastGap() seconds
+        RateDeviation,   ///< rate() left the tolerance
+        RateRecovered    ///< rate() is back within half the tolerance
+    };
+
+    /**
+     * @param config Thresholds
+     * @param sample_rate Nominal rate; 0 (irregular) disables both checks
+     * @param chunk_period Seconds of data per read at the nominal rate
+     */
+    RateMonitor(const Config& config, double sample_rate, double chunk_period);
+
+    /// Forget the history, e.g. when streaming starts or after a reconnect
+    void restart(Clock::time_point now);
+
+    /// Change the expected chunk period (adaptive or updated chunk sizes)
+    void setChunkPeriod(double chunk_period);
+
+    /// Account for a read that returned `samples` (possibly 0) at `now`
+    Event onRead(std::size_t samples, Clock::time_point now);
+
+    /// Effective rate over the last window (Hz); 0 until a window has passed
+    double rate() const { return rate_; }
+
+    /// Whether the rate is currently flagged
+    bool deviating() const { return deviating_; }
+
+    /// Length of the stall reported last (s): so far for Stall, in full for Resumed
+    double lastGap() const { return last_gap_; }
+
+    /// Whether a stall was reported and no data has arrived since
+    bool stalled() const { return stalled_; }
+
+    double sampleRate() const { return sample_rate_; }
+    double chunkPeriod() const { return chunk_period_; }
+
+    /// Whether any check is enabled
+    bool enabled() const { return stall_limit_ > 0.0 || config_.tolerance > 0.0; }
+
+private:
+    static constexpr std::size_t kSlots = 10;  // Evaluations per window
+
+    struct Checkpoint {
+        Clock::time_point time;
+        uint64_t samples = 0;  // Delivered up to and including the chunk at time
+    };
+
+    Event evaluate(Clock::time_point now);
+
+    Config config_;
+    double sample_rate_;
+    double chunk_period_ = 0.0;
+    double stall_limit_ = 0.0;  // Seconds; 0 = no stall check
+    Clock::duration slot_;
+
+    std::array<Checkpoint, kSlots + 1> checkpoints_{};
+    std::size_t oldest_ = 0;
+    std::size_t count_ = 0;
+    Clock::time_point next_checkpoint_;
+    Clock::time_point last_chunk_;
+    uint64_t samples_ = 0;
+
+    double rate_ = 0.0;
+    bool deviating_ = false;
+    double last_gap_ = 0.0;
+    bool stalled_ = false;
+};
+
+} // namespace lsltemplate
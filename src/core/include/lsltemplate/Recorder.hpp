@@ -0,0 +1,158 @@
+#pragma once
+/**
+ * @file Recorder.hpp
+ * @brief Local binary copy of a stream, written on its own thread
+ *
+ * The streaming thread hands every published chunk to a Recorder, which
+ * queues it in a drop-newest ChunkRing and returns immediately. A writer
+ * thread appends the chunks to preallocated, memory-mapped segment files
+ * and syncs them to disk periodically, so a slow or full disk costs
+ * recorded data (counted as dropped) but never stalls acquisition.
+ *
+ * File layout, host byte order. Each segment starts with a header:
+ *
+ *     char     magic[8]        "LSLTREC1"
+ *     uint32   header_bytes    Offset of the first record
+ *     uint32   format          SampleFormat
+ *     uint32   channels
+ *     uint32   segment         Index within the recording
+ *     double   sample_rate
+ *     uint32   name_length, then the stream name
+ *     uint32   source_id_length, then the source id
+ *
+ * followed by records:
+ *
+ *     uint32   samples         0 (unused preallocated space) or the end of
+ *                              the file ends the segment
+ *     uint32   payload_bytes
+ *     double   timestamp       LSL time of the last sample
+ *     double   sample_interval Earlier samples are spaced this far apart
+ *     payload                  samples * channels values, channel-interleaved;
+ *                              strings as uint32 length + bytes
+ */
+
+#include "ChunkRing.hpp"
+#include "Device.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace lsltemplate {
+
+/**
+ * @brief Recorder counters
+ */
+struct RecorderStats {
+    uint64_t chunks = 0;     ///< Chunks written
+    uint64_t samples = 0;    ///< Samples written
+    uint64_t bytes = 0;      ///< File bytes written, headers included
+    uint64_t dropped = 0;    ///< Chunks lost to a full queue or a write error
+    uint64_t segments = 0;   ///< Segment files opened
+    std::size_t queue_high_water = 0;  ///< Deepest queue observed (chunks)
+    bool failed = false;     ///< Writing stopped after an I/O error
+};
+
+/**
+ * @brief Tees published chunks into segment files without blocking
+ *
+ * One recording per object: start(), record() chunks, stop(). record() is
+ * called from one thread at a time (the publishing thread); stats() from
+ * any thread.
+ */
+class Recorder {
+public:
+    struct Config {
+        /// Base file name, e.g. "rec/eeg.lslrec"; empty disables recording.
+        /// Segments are written as <stem>_<start time>_<NNNN><extension>.
+        std::filesystem::path path;
+        std::size_t segment_bytes = std::size_t{64} << 20;  ///< Preallocated size per segment
+        std::chrono::milliseconds sync_interval{1000};      ///< Longest unsynced period
+        std::size_t queue_chunks = 64;  ///< Chunks buffered for the writer
+
+        bool operator==(const Config&) const = default;
+    };
+
+    /**
+     * @param config Recording settings
+     * @param info Stream being recorded
+     * @param max_chunk_samples Largest chunk record() will be given
+     * @param callback Optional status callback (called from the writer thread)
+     */
+    Recorder(const Config& config, const DeviceInfo& info, std::size_t max_chunk_samples,
+             StatusCallback callback = nullptr);
+
+    /// Writes out what is queued, closes the segment and joins the writer
+    ~Recorder();
+
+    Recorder(const Recorder&) = delete;
+    Recorder& operator=(const Recorder&) = delete;
+
+    /**
+     * @brief Open the first segment and start the writer thread
+     * @return false if the file could not be created
+     */
+    bool start();
+
+    /// Write out what is queued, close the segment and join the writer
+    void stop();
+
+    /**
+     * @brief Queue a chunk for writing; never blocks
+     * @param data Channel-interleaved samples of the stream's native type
+     * @param samples Number of samples (at most max_chunk_samples)
+     * @param timestamp LSL time of the last sample
+     * @param sample_interval Spacing of the earlier samples' timestamps
+     * @return false if the chunk was dropped
+     */
+    template <typename T>
+    bool record(const T* data, std::size_t samples, double timestamp, double sample_interval) {
+        auto& ring = static_cast<ChunkRing<T>&>(*ring_);
+        Chunk<T>& slot = ring.writeSlot();
+        samples = std::min(samples, max_chunk_samples_);
+        std::copy_n(data, samples * channels_, slot.data.begin());
+        slot.samples = samples;
+        slot.timestamp = timestamp;
+        slot.sample_interval = sample_interval;
+        return ring.commit();
+    }
+
+    RecorderStats stats() const;
+
+    /// File name of a segment
+    static std::filesystem::path segmentPath(const std::filesystem::path& base,
+                                             const std::string& session, std::size_t index);
+
+private:
+    class Writer;
+
+    void writerFunction();
+    template <typename T>
+    void drain(ChunkRing<T>& ring, Writer& writer);
+    void report(const std::string& message, bool is_error);
+
+    Config config_;
+    DeviceInfo info_;
+    std::size_t channels_;
+    std::size_t max_chunk_samples_;
+    StatusCallback statusCallback_;
+
+    std::unique_ptr<ChunkRingBase> ring_;
+    std::unique_ptr<Writer> writer_;
+    std::unique_ptr<std::thread> thread_;
+
+    // Written by the writer thread
+    std::atomic<uint64_t> chunks_{0};
+    std::atomic<uint64_t> samples_{0};
+    std::atomic<uint64_t> bytes_{0};
+    std::atomic<uint64_t> lost_{0};  // Dequeued after a write error
+    std::atomic<uint64_t> segments_{0};
+    std::atomic<bool> failed_{false};
+};
+
+} // namespace lsltemplate
@@ -0,0 +1,100 @@
+#pragma once
+/**
+ * @file SampleFormat.hpp
+ * @brief Channel formats supported end-to-end from device to LSL outlet
+ *
+ * Each format maps to one C++ sample type, so device buffers can be handed
+ * to the matching liblsl overload without per-sample conversion.
+ */
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace lsltemplate {
+
+/**
+ * @brief Channel format of a stream
+ */
+enum class SampleFormat {
+    Float32,
+    Double64,
+    String,
+    Int32,
+    Int16,
+    Int8,
+    Int64
+};
+
+/// True for the C++ types that carry samples (float, double, std::string, intN_t)
+template <typename T>
+inline constexpr bool is_sample_type_v =
+    std::is_same_v<T, float> || std::is_same_v<T, double> ||
+    std::is_same_v<T, std::string> || std::is_same_v<T, int32_t> ||
+    std::is_same_v<T, int16_t> || std::is_same_v<T, int8_t> ||
+    std::is_same_v<T, int64_t>;
+
+/// Format corresponding to a sample type
+template <typename T>
+constexpr SampleFormat sampleFormatOf() {
+    static_assert(is_sample_type_v<T>, "Unsupported sample type");
+    if constexpr (std::is_same_v<T, float>) return SampleFormat::Float32;
+    else if constexpr (std::is_same_v<T, double>) return SampleFormat::Double64;
+    else if constexpr (std::is_same_v<T, std::string>) return SampleFormat::String;
+    else if constexpr (std::is_same_v<T, int32_t>) return SampleFormat::Int32;
+    else if constexpr (std::is_same_v<T, int16_t>) return SampleFormat::Int16;
+    else if constexpr (std::is_same_v<T, int8_t>) return SampleFormat::Int8;
+    else return SampleFormat::Int64;
+}
+
+/**
+ * @brief Call `f.template operator()<T>()` with the sample type of a format
+ *
+ * Typical use with a templated lambda:
+ * @code
+ * visitSampleFormat(info.format, [&]<typename T>() { run<T>(); });
+ * @endcode
+ */
+template <typename F>
+decltype(auto) visitSampleFormat(SampleFormat format, F&& f) {
+    switch (format) {
+        case SampleFormat::Double64: return f.template operator()<double>();
+        case SampleFormat::String: return f.template operator()<std::string>();
+        case SampleFormat::Int32: return f.template operator()<int32_t>();
+        case SampleFormat::Int16: return f.template operator()<int16_t>();
+        case SampleFormat::Int8: return f.template operator()<int8_t>();
+        case SampleFormat::Int64: return f.template operator()<int64_t>();
+        case SampleFormat::Float32: break;
+    }
+    return f.template operator()<float>();
+}
+
+/// Parse a format name as used in config files ("float32", "int16", ...)
+inline std::optional<SampleFormat> parseSampleFormat(std::string_view name) {
+    if (name == "float32" || name == "float") return SampleFormat::Float32;
+    if (name == "double64" || name == "double") return SampleFormat::Double64;
+    if (name == "string") return SampleFormat::String;
+    if (name == "int32") return SampleFormat::Int32;
+    if (name == "int16") return SampleFormat::Int16;
+    if (name == "int8") return SampleFormat::Int8;
+    if (name == "int64") return SampleFormat::Int64;
+    return std::nullopt;
+}
+
+/// Config-file spelling of a format
+inline const char* toString(SampleFormat format) {
+    switch (format) {
+        case SampleFormat::Double64: return "double64";
+        case SampleFormat::String: return "string";
+        case SampleFormat::Int32: return "int32";
+        case SampleFormat::Int16: return "int16";
+        case SampleFormat::Int8: return "int8";
+        case SampleFormat::Int64: return "int64";
+        case SampleFormat::Float32: break;
+    }
+    return "float32";
+}
+
+} // namespace lsltemplate
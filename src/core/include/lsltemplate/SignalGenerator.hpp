@@ -0,0 +1,131 @@
+#pragma once
+/**
+ * @file SignalGenerator.hpp
+ * @brief High-rate synthetic multi-channel signal source
+ *
+ * Produces per-channel sine, square, chirp, pink-noise and counter
+ * waveforms into a channel-interleaved buffer using vectorized kernels
+ * (AVX2 or NEON, chosen at runtime, with a scalar fallback). Intended for
+ * load-testing the outlet path without the generator becoming the
+ * bottleneck.
+ */
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace lsltemplate {
+
+namespace simd {
+struct SignalKernels;
+}
+
+/**
+ * @brief Waveform of one synthetic channel
+ */
+enum class Waveform {
+    Sine,
+    Square,
+    Chirp,      ///< Linear sweep from frequency to end_frequency, repeating
+    PinkNoise,  ///< 1/f noise, deterministic for a given seed
+    Counter     ///< Increments by amplitude every sample, starting at phase
+};
+
+/// Parse "sine", "square", "chirp", "pink" or "counter"
+std::optional<Waveform> parseWaveform(std::string_view name);
+
+/// Config-file spelling of a waveform
+const char* toString(Waveform waveform);
+
+/**
+ * @brief Settings of one synthetic channel
+ */
+struct ChannelSignal {
+    Waveform waveform = Waveform::Sine;
+    double amplitude = 1.0;
+    double frequency = 10.0;       ///< Hz (start frequency for Chirp)
+    double phase = 0.0;            ///< Radians (start value for Counter)
+    double end_frequency = 100.0;  ///< Chirp end frequency in Hz
+};
+
+/**
+ * @brief Build per-channel settings from comma-separated lists
+ *
+ * Each list gives one value per channel; a list shorter than the longest
+ * one repeats its last entry. Empty lists keep the ChannelSignal default.
+ *
+ * @return Channel settings, or nullopt if any entry fails to parse
+ */
+std::optional<std::vector<ChannelSignal>> parseChannelSignals(
+    std::string_view waveforms,
+    std::string_view amplitudes = {},
+    std::string_view frequencies = {},
+    std::string_view phases = {},
+    std::string_view end_frequencies = {}
+);
+
+/**
+ * @brief Vectorized synthetic signal generator
+ *
+ * Channels with the same waveform are grouped into contiguous runs; each
+ * run is generated a SIMD register of channels at a time with the
+ * oscillator state kept in registers across the whole chunk. Sine and
+ * square use a rotating phasor (no transcendental calls per sample); chirp
+ * updates the phasor rotation every few samples in double precision.
+ */
+class SignalGenerator {
+public:
+    struct Config {
+        int channel_count = 1;
+        double sample_rate = 1000.0;
+        std::vector<ChannelSignal> channels;  ///< Per channel; the last entry repeats
+        double chirp_period = 1.0;            ///< Seconds per chirp sweep
+        uint64_t seed = 1;                    ///< Pink noise seed
+    };
+
+    explicit SignalGenerator(const Config& config);
+
+    /// Restart all waveforms from their initial phase and seed
+    void reset();
+
+    /**
+     * @brief Generate the next samples
+     * @param out Channel-interleaved destination; its size must be a
+     *            multiple of the channel count
+     */
+    void generate(std::span<float> out);
+
+    /// Instruction set in use ("avx2", "neon" or "scalar")
+    const char* isa() const;
+
+private:
+    struct Run {
+        Waveform waveform;
+        std::size_t first;  ///< First channel of the run
+        std::size_t count;  ///< Number of channels
+    };
+
+    void generateBlock(float* out, std::size_t samples);
+    void updateChirp();
+    void renormalize();
+
+    Config config_;
+    std::size_t channels_ = 1;
+    std::vector<ChannelSignal> signals_;  // One per channel
+    std::vector<Run> runs_;
+    const simd::SignalKernels* kernels_ = nullptr;
+
+    // Per-channel state, structure-of-arrays
+    std::vector<float> re_, im_, cr_, ci_, amplitude_;
+    std::vector<float> value_, step_;
+    std::vector<float> poles_;  // 7 * channels
+    std::vector<uint32_t> rng_;
+
+    uint64_t chirp_position_ = 0;  // Samples into the current sweep
+    uint64_t chirp_length_ = 1;    // Samples per sweep
+};
+
+} // namespace lsltemplate
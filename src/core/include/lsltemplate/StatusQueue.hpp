@@ -0,0 +1,145 @@
+#pragma once
+/**
+ * @file StatusQueue.hpp
+ * @brief Non-blocking status reporting from the streaming threads
+ *
+ * A StatusCallback may write to a terminal or post to a UI event loop and
+ * take arbitrarily long. Streaming threads hand their messages to a
+ * StatusQueue instead, which passes them on from a thread of its own.
+ */
+
+#include "Device.hpp"
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+
+namespace lsltemplate {
+
+/**
+ * @brief Bounded lock-free queue of status messages drained by a thread
+ *
+ * info() and error() format their arguments (strings and numbers) straight
+ * into a fixed-size slot of a preallocated ring: they never allocate, lock
+ * or wait, and return false if the ring is full. Messages longer than
+ * kMaxLength are truncated. Any number of threads may post.
+ *
+ * The drain thread passes messages on to the callback in order, with two
+ * protections for the receiving end: consecutive repeats of a message are
+ * coalesced into one "(repeated N more times)" report, and at most
+ * `max_rate` messages per second (after an initial `burst`) get through.
+ * What was dropped, by either limit or a full ring, is counted and
+ * reported every `summary_interval`.
+ */
+class StatusQueue {
+public:
+    struct Config {
+        std::size_t capacity = 256;          ///< Messages; rounded up to a power of two
+        double max_rate = 20.0;              ///< Messages per second passed on; 0 = unlimited
+        std::size_t burst = 50;              ///< Messages passed on at once before max_rate applies
+        std::chrono::milliseconds summary_interval{1000};  ///< Repeat and drop reports
+        std::chrono::milliseconds drain_interval{10};      ///< Drain thread wake-up period
+    };
+
+    static constexpr std::size_t kMaxLength = 240;
+
+    /**
+     * @param callback Receives the messages on the drain thread; without
+     *                 one, nothing is queued and no thread is started
+     */
+    explicit StatusQueue(StatusCallback callback);
+    StatusQueue(const Config& config, StatusCallback callback);
+
+    /// Passes on what is still queued, then stops the drain thread
+    ~StatusQueue();
+
+    StatusQueue(const StatusQueue&) = delete;
+    StatusQueue& operator=(const StatusQueue&) = delete;
+
+    /// Queue the concatenation of parts as an informational message
+    template <typename... Parts>
+    bool info(const Parts&... parts) { return post(false, parts...); }
+
+    /// Queue the concatenation of parts as an error
+    template <typename... Parts>
+    bool error(const Parts&... parts) { return post(true, parts...); }
+
+    /// A callback that queues here, for code reporting through StatusCallback
+    StatusCallback callback();
+
+    /**
+     * @brief Wait until everything queued so far has been passed on
+     *
+     * Pending repeat and drop counts are reported as well. Call it from a
+     * control thread, e.g. before reporting that streaming stopped.
+     */
+    void flush();
+
+private:
+    struct Slot {
+        std::atomic<std::size_t> sequence{0};  // Ring position this slot is ready for
+        bool is_error = false;
+        std::uint16_t length = 0;
+        char text[kMaxLength];
+    };
+
+    template <typename... Parts>
+    bool post(bool is_error, const Parts&... parts) {
+        if (!callback_) {
+            return true;
+        }
+        Slot* slot = claim();
+        if (!slot) {
+            return false;
+        }
+        slot->is_error = is_error;
+        slot->length = 0;
+        (append(*slot, parts), ...);
+        publish(*slot);
+        return true;
+    }
+
+    template <typename Part>
+    static void append(Slot& slot, const Part& part) {
+        if constexpr (std::is_same_v<Part, bool>) {
+            appendText(slot, part ? "true" : "false");
+        } else if constexpr (std::is_integral_v<Part>) {
+            char buffer[24];
+            const auto result = std::to_chars(buffer, buffer + sizeof(buffer), part);
+            appendText(slot, std::string_view(buffer, static_cast<std::size_t>(result.ptr - buffer)));
+        } else if constexpr (std::is_floating_point_v<Part>) {
+            appendNumber(slot, static_cast<double>(part));
+        } else {
+            appendText(slot, std::string_view(part));
+        }
+    }
+
+    static void appendText(Slot& slot, std::string_view text);
+    static void appendNumber(Slot& slot, double value);
+
+    Slot* claim();
+    void publish(Slot& slot);
+    void drainFunction();
+
+    Config config_;
+    StatusCallback callback_;
+
+    std::unique_ptr<Slot[]> slots_;
+    std::size_t mask_ = 0;
+    alignas(64) std::atomic<std::size_t> enqueue_pos_{0};
+    alignas(64) std::atomic<uint64_t> overflowed_{0};  // Posts that found the ring full
+
+    // Drain thread
+    std::size_t dequeue_pos_ = 0;
+    std::atomic<uint64_t> flush_requests_{0};
+    std::atomic<uint64_t> flushed_{0};
+    std::atomic<bool> shutdown_{false};
+    std::thread thread_;
+};
+
+} // namespace lsltemplate
@@ -0,0 +1,147 @@
+#pragma once
+/**
+ * @file StreamManager.hpp
+ * @brief Many device/outlet pairs served by a shared worker pool
+ *
+ * StreamThread dedicates an OS thread to each device. Hosts running dozens
+ * of low-rate sensors instead register them all with one StreamManager,
+ * which polls each device on a fixed schedule from a small pool of
+ * workers.
+ */
+
+#include "Device.hpp"
+#include "StatusQueue.hpp"
+#include "StreamThread.hpp"
+#include "ThreadScheduling.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace lsltemplate {
+
+/**
+ * @brief Schedules acquisition of many streams on a fixed-size thread pool
+ *
+ * Each running stream has an absolute poll deadline in a shared min-heap.
+ * Idle workers sleep until the earliest deadline, take that stream, read
+ * whatever the device has ready and push it to the stream's outlet, then
+ * reschedule it one poll interval later (immediately if the read filled
+ * the buffer). A stream is only ever handled by one worker at a time.
+ *
+ * Devices must not block in getData(): they return the samples available
+ * now, possibly none (see MockDevice::Config::blocking). Use StreamThread
+ * for devices whose reads block until data arrives.
+ *
+ * add/start/stop may be called from any thread.
+ */
+class StreamManager {
+public:
+    using StreamId = std::size_t;
+
+    struct Config {
+        std::size_t workers = 0;  ///< Pool size; 0 = min(4, hardware threads)
+        std::chrono::milliseconds poll_interval{20};  ///< Per-stream poll period
+
+        /// Hold data back from outlets without consumers, keeping the last
+        /// `preroll` seconds per stream (see StreamThread::Config)
+        bool gate_on_consumers = false;
+        double preroll = 2.0;
+
+        /// Scheduling of every worker, and memory locking before they start
+        /// (see StreamThread::Config)
+        ThreadScheduling scheduling;
+        bool lock_memory = false;
+    };
+
+    explicit StreamManager(StatusCallback callback = nullptr);
+    StreamManager(const Config& config, StatusCallback callback = nullptr);
+
+    /// Stops all streams and joins the workers
+    ~StreamManager();
+
+    // Non-copyable, non-movable (owns running threads)
+    StreamManager(const StreamManager&) = delete;
+    StreamManager& operator=(const StreamManager&) = delete;
+
+    /**
+     * @brief Register a device (takes ownership); it is not started yet
+     * @param device Device to stream from
+     * @param recording Local copy of the stream (none if the path is empty)
+     * @param filters Biquads applied to every read (see StreamThread::Config)
+     * @param channel_layout Per-channel metadata (see StreamThread::Config)
+     * @return Identifier for the per-stream calls
+     */
+    StreamId add(std::unique_ptr<IDevice> device, const Recorder::Config& recording = {},
+                 const std::vector<FilterSpec>& filters = {},
+                 const std::vector<ChannelDescription>& channel_layout = {});
+
+    /**
+     * @brief Connect the device, create its outlet and begin polling
+     *
+     * A stream whose device failed or ran out of data keeps its outlet until it
+     * is stopped or started again; start() tears it down and reconnects,
+     * so startAll() restarts every failed stream.
+     *
+     * @return true if started successfully
+     */
+    bool start(StreamId id);
+
+    /// Stop polling, destroy the outlet and disconnect the device
+    void stop(StreamId id);
+
+    /// Start every registered stream; true if all started
+    bool startAll();
+
+    /// Stop every stream; polls still in progress are waited for together
+    void stopAll();
+
+    /// Whether the stream is started and has not failed
+    bool isRunning(StreamId id) const;
+
+    /// Number of running streams
+    std::size_t runningCount() const;
+
+    /// Number of registered streams
+    std::size_t size() const;
+
+    std::size_t workerCount() const { return workers_.size(); }
+
+    DeviceInfo getDeviceInfo(StreamId id) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+    struct Stream;
+
+    struct Deadline {
+        Clock::time_point due;
+        StreamId id;
+        uint64_t generation;  // Stale once the stream is stopped or restarted
+
+        bool operator>(const Deadline& other) const { return due > other.due; }
+    };
+
+    void workerFunction();
+    void teardown(Stream& stream);  // Of a stream no worker polls any more
+    void report(const std::string& message, bool is_error);
+
+    Config config_;
+    StatusCallback statusCallback_;  // Control thread
+    StatusQueue status_;             // Workers; drained into statusCallback_
+
+    std::mutex control_mutex_;  // Serializes start/stop of streams
+    mutable std::mutex mutex_;  // Guards everything below
+    std::condition_variable wake_;  // Schedule changed or shutting down
+    std::condition_variable idle_;  // A stream finished a poll
+    std::priority_queue<Deadline, std::vector<Deadline>, std::greater<>> schedule_;
+    std::vector<std::unique_ptr<Stream>> streams_;
+    bool shutdown_ = false;
+
+    std::vector<std::thread> workers_;
+};
+
+} // namespace lsltemplate
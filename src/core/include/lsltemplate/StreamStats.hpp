@@ -0,0 +1,192 @@
+#pragma once
+/**
+ * @file StreamStats.hpp
+ * @brief Runtime statistics of a streaming pipeline
+ *
+ * The streaming threads record into StatsRecorder with relaxed atomic
+ * stores only (each counter has a single writer), so monitoring from
+ * another thread never takes a lock or stalls acquisition.
+ */
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace lsltemplate {
+
+/**
+ * @brief Log-linear duration histogram
+ *
+ * Each power-of-two range of nanoseconds is split into four buckets, so a
+ * reported quantile is within ~25% of the true value from 4 ns to ~8.6 s;
+ * longer durations land in the last bucket.
+ */
+struct DurationHistogram {
+    static constexpr std::size_t kSubBuckets = 4;  // Per octave
+    static constexpr std::size_t kBuckets = 128;
+
+    std::array<uint64_t, kBuckets> counts{};
+
+    static std::size_t bucketOf(uint64_t nanoseconds) {
+        if (nanoseconds < kSubBuckets) {
+            return static_cast<std::size_t>(nanoseconds);
+        }
+        const auto octave = static_cast<std::size_t>(std::bit_width(nanoseconds)) - 1;  // >= 2
+        const auto sub = static_cast<std::size_t>(nanoseconds >> (octave - 2)) & (kSubBuckets - 1);
+        const std::size_t bucket = (octave - 1) * kSubBuckets + sub;
+        return bucket < kBuckets ? bucket : kBuckets - 1;
+    }
+
+    /// Upper edge of a bucket in seconds
+    static double upperBound(std::size_t bucket) {
+        if (bucket < kSubBuckets) {
+            return static_cast<double>(bucket + 1) * 1e-9;
+        }
+        const std::size_t octave = bucket / kSubBuckets + 1;
+        const std::size_t sub = bucket % kSubBuckets;
+        return static_cast<double>((kSubBuckets + 1 + sub) << (octave - 2)) * 1e-9;
+    }
+
+    uint64_t total() const {
+        uint64_t sum = 0;
+        for (uint64_t count : counts) {
+            sum += count;
+        }
+        return sum;
+    }
+
+    /// Upper edge (s) of the bucket holding the p-th quantile, p in [0, 1]
+    double percentile(double p) const {
+        const uint64_t n = total();
+        if (n == 0) {
+            return 0.0;
+        }
+        const auto rank = static_cast<uint64_t>(p * static_cast<double>(n - 1)) + 1;
+        uint64_t seen = 0;
+        for (std::size_t i = 0; i < kBuckets; ++i) {
+            seen += counts[i];
+            if (seen >= rank) {
+                return upperBound(i);
+            }
+        }
+        return upperBound(kBuckets - 1);
+    }
+};
+
+/**
+ * @brief Snapshot of a stream's counters
+ *
+ * Counters are cumulative since start(); rates over an interval are the
+ * difference of two snapshots divided by the difference of their elapsed.
+ */
+struct StreamStats {
+    double elapsed = 0.0;            ///< Seconds since start()
+    uint64_t samples_pushed = 0;
+    uint64_t chunks_pushed = 0;
+    uint64_t bytes_pushed = 0;       ///< Payload bytes (string lengths for strings)
+    uint64_t read_calls = 0;         ///< getData() calls, including empty reads
+    uint64_t overruns = 0;           ///< Iterations whose processing outlasted their chunk
+    uint64_t consumer_changes = 0;   ///< Transitions between having and not having consumers
+    bool has_consumers = false;
+    uint64_t samples_gated = 0;      ///< Held back from liblsl while nobody was listening
+    uint64_t preroll_discarded = 0;  ///< Gated samples that aged out of the pre-roll
+    double effective_rate = 0.0;     ///< samples_pushed / elapsed (Hz)
+    uint64_t chunk_samples = 0;      ///< Current samples per device read
+    uint64_t reconnects = 0;         ///< Device reconnections after read errors
+    uint64_t samples_missed = 0;     ///< Nominal-rate samples that fell into reconnect gaps
+    double delivered_rate = 0.0;     ///< Device rate over the last RateMonitor window (Hz; 0 until one passed)
+    bool rate_deviating = false;     ///< delivered_rate is off nominal beyond the tolerance
+    uint64_t stalls = 0;             ///< Gaps between reads beyond the stall limit
+    double since_data = 0.0;         ///< Seconds since the device last delivered samples
+
+    DurationHistogram get_data;      ///< Time spent inside getData()
+    DurationHistogram push_chunk;    ///< Time spent inside pushChunk()
+    DurationHistogram recovery;      ///< From a read error to the device being connected again
+};
+
+/**
+ * @brief Lock-free counters behind StreamStats
+ *
+ * Acquisition-side and publisher-side counters live on separate cache
+ * lines and are each written by one thread only, so updates are plain
+ * relaxed load/store pairs rather than read-modify-write instructions.
+ * snapshot() may be called from any thread.
+ */
+class StatsRecorder {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// Zero everything and restart the elapsed clock (before threads start)
+    void reset();
+
+    // Acquisition thread
+    void recordRead(Clock::duration duration);
+    void recordOverrun() { bump(acquisition_.overruns); }
+    void setChunkSamples(uint64_t samples) {
+        acquisition_.chunk_samples.store(samples, std::memory_order_relaxed);
+    }
+    void recordReconnect(Clock::duration recovery, uint64_t samples_missed);
+    void recordData(Clock::time_point now) {
+        acquisition_.last_data.store((now - started()).count(), std::memory_order_relaxed);
+    }
+    void recordStall() { bump(acquisition_.stalls); }
+    void recordRate(double rate, bool deviating) {
+        acquisition_.delivered_rate.store(rate, std::memory_order_relaxed);
+        acquisition_.rate_deviating.store(deviating, std::memory_order_relaxed);
+    }
+
+    // Publisher thread
+    void recordPush(uint64_t samples, uint64_t bytes, Clock::duration duration);
+    void recordConsumers(bool has_consumers);
+    void recordGated(uint64_t samples, uint64_t discarded) {
+        bump(publisher_.gated, samples);
+        bump(publisher_.discarded, discarded);
+    }
+
+    StreamStats snapshot() const;
+
+private:
+    using Buckets = std::array<std::atomic<uint64_t>, DurationHistogram::kBuckets>;
+
+    static void bump(std::atomic<uint64_t>& counter, uint64_t n = 1) {
+        counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+    static void record(Buckets& buckets, Clock::duration duration);
+
+    Clock::time_point started() const {
+        return Clock::time_point(Clock::duration(started_.load(std::memory_order_relaxed)));
+    }
+
+    struct alignas(64) Acquisition {
+        std::atomic<uint64_t> read_calls{0};
+        std::atomic<uint64_t> overruns{0};
+        std::atomic<uint64_t> chunk_samples{0};
+        std::atomic<uint64_t> reconnects{0};
+        std::atomic<uint64_t> samples_missed{0};
+        std::atomic<Clock::rep> last_data{0};  // Since started_
+        std::atomic<uint64_t> stalls{0};
+        std::atomic<double> delivered_rate{0.0};
+        std::atomic<bool> rate_deviating{false};
+        Buckets get_data{};
+        Buckets recovery{};
+    };
+    struct alignas(64) Publisher {
+        std::atomic<uint64_t> samples{0};
+        std::atomic<uint64_t> chunks{0};
+        std::atomic<uint64_t> bytes{0};
+        std::atomic<uint64_t> consumer_changes{0};
+        std::atomic<bool> has_consumers{false};
+        std::atomic<uint64_t> gated{0};
+        std::atomic<uint64_t> discarded{0};
+        Buckets push_chunk{};
+    };
+
+    Acquisition acquisition_;
+    Publisher publisher_;
+    std::atomic<Clock::rep> started_{Clock::now().time_since_epoch().count()};  // Written by reset()
+};
+
+} // namespace lsltemplate
@@ -6,25 +6,137 @@
  * Manages the acquisition loop in a separate thread.
  */
 
+#include "ChannelSplit.hpp"
+#include "ChunkRing.hpp"
+#include "ClockEstimator.hpp"
+#include "Decimator.hpp"
 #include "Device.hpp"
+#include "FilterChain.hpp"
 #include "LSLOutlet.hpp"
+#include "Pacer.hpp"
+#include "PrerollBuffer.hpp"
+#include "PreviewBuffer.hpp"
+#include "RateMonitor.hpp"
+#include "Recorder.hpp"
+#include "StatusQueue.hpp"
+#include "StreamStats.hpp"
+#include "ThreadScheduling.hpp"
 #include <atomic>
+#include <chrono>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <stop_token>
 #include <thread>
+#include <vector>
 
 namespace lsltemplate {
 
-/**
- * @brief Status callback type
- */
-using StatusCallback = std::function<void(const std::string& message, bool is_error)>;
-
 /**
  * @brief Manages device acquisition and LSL streaming in a background thread
  */
 class StreamThread {
 public:
+    /**
+     * @brief Streaming pipeline settings
+     */
+    struct Config {
+        /// Seconds of data per device read, also the outlet's transmit
+        /// chunk size. Shorter lowers latency, longer lowers overhead.
+        /// In adaptive mode this is the largest chunk allowed.
+        double chunk_duration = 0.1;
+        int max_buffered = 360;  ///< Outlet buffer, see LSLOutlet
+
+        /// Resize chunks at runtime: aim for latency_target, but grow while
+        /// pushChunk() would take more than cpu_budget of the stream's time
+        bool adaptive_chunk = false;
+        double latency_target = 0.02;  ///< Seconds per chunk to aim for
+        double cpu_budget = 0.01;      ///< Fraction of real time for pushing
+
+        /// Acquire and publish on separate threads connected by a ChunkRing,
+        /// so stalls inside liblsl do not delay the next device read
+        bool decoupled = false;
+        std::size_t ring_capacity = 32;  ///< Chunks buffered between the stages
+        OverflowPolicy overflow_policy = OverflowPolicy::Block;
+
+        /// Fit device time (hardware timestamps, or sample count / nominal
+        /// rate) against lsl::local_clock() and stamp every sample from the
+        /// fit. Always on for devices reporting TimestampClock::Device.
+        bool dejitter = false;
+
+        /// Release chunks at the nominal rate against absolute deadlines,
+        /// for software-timed devices whose reads return immediately
+        bool pace = false;
+        std::chrono::microseconds pacing_spin{0};  ///< See Pacer::Config::spin
+
+        /// On a device read error, reconnect with exponential backoff
+        /// instead of ending the stream. The outlets stay up, so consumers
+        /// see a gap in the timestamps rather than losing the stream.
+        bool reconnect = false;
+        double reconnect_delay = 0.05;     ///< Seconds before the first attempt; doubles after each
+        double reconnect_max_delay = 2.0;  ///< Longest wait between attempts
+        double reconnect_timeout = 0.0;    ///< Give up after this many seconds; 0 = never
+
+        /// Compare what the device delivers against its nominal rate and
+        /// report stalls and rate deviations (see RateMonitor; off while both
+        /// thresholds are 0, and for irregular streams)
+        RateMonitor::Config rate_monitor;
+
+        /// Only push into liblsl while an inlet is connected. Until then the
+        /// last `preroll` seconds are kept in-process and flushed, with their
+        /// original timestamps, when the first consumer appears.
+        bool gate_on_consumers = false;
+        double preroll = 2.0;  ///< Seconds held while gated (x100 samples if irregular)
+
+        /// Filter every chunk in place after reading it (float32 and
+        /// double64 streams; start() fails for other formats)
+        std::vector<FilterSpec> filters;
+
+        /// Also publish anti-aliased copies at sample_rate / factor, one
+        /// outlet per factor (float32 and double64 streams). A factor that
+        /// is a multiple of a smaller one decimates that one's output.
+        std::vector<std::size_t> decimation;
+
+        /// Per-channel labels, units, types and locations for the stream
+        /// description (see ChannelLayout); one entry per device channel,
+        /// or empty for the device's own
+        std::vector<ChannelDescription> channel_layout;
+
+        /// Also publish channel subsets as streams of their own (e.g. the
+        /// EMG channels of an EEG amplifier), each with its own name, type
+        /// and labels. The full stream is published as before.
+        std::vector<ChannelSplit> splits;
+
+        /// Also write every chunk, as pushed, to local segment files
+        /// (disabled while recording.path is empty)
+        Recorder::Config recording;
+
+        /// Keep a min/max envelope of the published signal for a local
+        /// display (disabled while preview.columns is 0; numeric formats)
+        PreviewBuffer::Config preview;
+
+        /// Scheduling of the acquisition thread, and of the publisher thread
+        /// when decoupled; settings the process may not apply are reported
+        /// and skipped
+        ThreadScheduling acquisition_scheduling;
+        ThreadScheduling publisher_scheduling;
+
+        /// Lock the process in RAM (see lockMemory()) and pre-fault the
+        /// streaming threads' stacks before the first read
+        bool lock_memory = false;
+
+        bool operator==(const Config&) const = default;
+    };
+
+    /// Outcome of update()
+    enum class UpdateResult {
+        Applied,       ///< Takes effect from the next chunk
+        Unchanged,     ///< Nothing to do
+        NeedsRestart,  ///< Changes the stream or pipeline: stop() and start a new one
+        Invalid        ///< Rejected, nothing changed (reported through the status callback)
+    };
+
     /**
      * @brief Construct a stream thread for the given device
      * @param device Device to stream from (takes ownership)
@@ -35,6 +147,18 @@ public:
         StatusCallback callback = nullptr
     );
 
+    /**
+     * @brief Construct a stream thread with explicit pipeline settings
+     * @param device Device to stream from (takes ownership)
+     * @param config Pipeline settings
+     * @param callback Optional status callback for notifications
+     */
+    StreamThread(
+        std::unique_ptr<IDevice> device,
+        const Config& config,
+        StatusCallback callback = nullptr
+    );
+
     ~StreamThread();
 
     // Non-copyable, non-movable (owns a running thread)
@@ -50,24 +174,136 @@ public:
     /**
      * @brief Stop streaming
      *
-     * Signals the thread to stop and waits for it to finish.
+     * Requests a stop and waits for the streaming threads to finish. Every
+     * wait in the pipeline (pacing, reconnect backoff, the chunk ring, the
+     * built-in devices) wakes on the request, so this takes as long as the
+     * device needs to return from getData() (see IDevice) plus tearing
+     * down the outlets. To stop many streams, requestStop() all of them
+     * first so that they wind down in parallel.
      */
     void stop();
 
+    /// Ask the streaming threads to finish without waiting for them
+    void requestStop();
+
+    /**
+     * @brief Change settings while streaming, without touching the outlet
+     *
+     * Filters and, unless adaptive, the chunk duration (up to the one the
+     * stream was started with) can change in place; so can the device
+     * parameter if the device supports it (see IDevice::setParameter()).
+     * The changes are prepared here, off the streaming threads, and swapped
+     * in by the acquisition thread between two reads. New filters start
+     * from a cleared state. Any other difference from the running
+     * configuration returns NeedsRestart.
+     *
+     * @param config Complete new settings
+     * @param device_parameter New device parameter, if it changed
+     */
+    UpdateResult update(const Config& config, std::optional<int> device_parameter = std::nullopt);
+
     /// Check if currently streaming
     bool isRunning() const;
 
     /// Get the device info
     DeviceInfo getDeviceInfo() const;
 
+    /// Ring occupancy counters (all zero unless running decoupled)
+    RingStats getRingStats() const;
+
+    /// Current device-to-LSL clock model (all zero unless dejittering)
+    ClockEstimate getClockEstimate() const;
+
+    /// Throughput and timing counters; lock-free, safe to poll at any rate
+    StreamStats getStats() const;
+
+    /// Local recording counters (all zero unless recording)
+    RecorderStats getRecorderStats() const;
+
+    /// Envelope of the published signal, or nullptr if disabled. Read it
+    /// from one thread only (see PreviewBuffer::latest()); valid until the
+    /// next start().
+    PreviewBuffer* preview() const { return preview_.get(); }
+
 private:
-    void threadFunction();
+    void threadFunction(std::stop_token stop);
+    void applyUpdate();
+    bool reconnectDevice();
+    void monitorRate(std::size_t samples, std::chrono::steady_clock::time_point now);
+
+    // Per-chunk stages. acquire() runs on the acquisition thread, publish()
+    // on the publisher thread (the same thread unless decoupled).
+    template <typename T>
+    bool acquire(Chunk<T>& chunk);
+    template <typename T>
+    void publish(const Chunk<T>& chunk, LSLOutlet& outlet);
+    template <typename T>
+    void flushPreroll(PrerollBuffer<T>& preroll, LSLOutlet& outlet);
+    template <typename T>
+    void publishDerived(const Chunk<T>& chunk, double sample_interval);
+    void createDerivedOutlets();
+    template <typename T>
+    void publishSplits(const Chunk<T>& chunk);
+    void createSplitOutlets();
+    void stampChunk(std::size_t samples, double device_timestamp,
+                    double& timestamp, double& sample_interval);
+    void adaptChunkSize();
+
+    // Acquisition loops, instantiated for the device's native sample type
+    template <typename T>
+    void runDirect(LSLOutlet& outlet);
+    template <typename T>
+    void runDecoupled(LSLOutlet& outlet, ChunkRing<T>& ring);
 
     std::unique_ptr<IDevice> device_;
-    std::unique_ptr<std::thread> thread_;
+    Config config_;
+    DeviceInfo info_;  // Snapshot taken by start()
+    std::unique_ptr<ChunkRingBase> ring_;
+    std::unique_ptr<Recorder> recorder_;  // Outlives the threads, like ring_
+    std::unique_ptr<PreviewBuffer> preview_;  // Likewise
+    std::unique_ptr<FilterChain> filters_;
+    std::unique_ptr<ChannelSplitterBase> splitter_;
+
+    // Settings changed by update(), swapped in by applyUpdate() between reads
+    struct PendingUpdate;
+    std::mutex update_mutex_;
+    std::unique_ptr<PendingUpdate> pending_;  // Not yet applied
+    std::unique_ptr<PendingUpdate> retired_;  // Replaced state, freed off the streaming threads
+    std::atomic<bool> update_pending_{false};
+
+    // Acquisition thread state
+    ClockEstimator clock_;
+    uint64_t samples_acquired_ = 0;
+    Pacer pacer_;  // Also measures the achieved rate when not pacing
+    std::chrono::steady_clock::time_point last_read_end_;
+    double last_chunk_duration_ = 0.0;  // Real-time length of the previous chunk (s)
+    std::size_t chunk_samples_ = 1;      // Samples per read (adaptive mode changes it)
+    std::size_t max_chunk_samples_ = 1;  // Buffer size
+    uint64_t samples_since_adapt_ = 0;
+    std::unique_ptr<RateMonitor> rate_monitor_;  // Only while a check is enabled
+
+    // Publisher thread state
+    struct DerivedOutlet;
+    std::vector<std::unique_ptr<DerivedOutlet>> derived_;  // Lower-rate copies
+    std::vector<std::unique_ptr<LSLOutlet>> split_outlets_;  // One per splitter_ output
+    std::vector<double> input_times_;  // Timestamps of the chunk being fanned out
+    std::atomic<double> push_cost_{0.0};  // Smoothed seconds per pushChunk()
+    std::vector<double> sample_times_;
+    std::unique_ptr<PrerollBufferBase> preroll_;  // Only when gating on consumers
+
+    StatsRecorder stats_;
+
+    // Clock model published for getClockEstimate()
+    std::atomic<double> clock_offset_{0.0};
+    std::atomic<double> clock_drift_ppm_{0.0};
+    std::atomic<double> clock_jitter_{0.0};
+    std::atomic<uint64_t> clock_updates_{0};
+
+    std::jthread thread_;
+    std::stop_token stop_;  // thread_'s, for the streaming threads
     std::atomic<bool> running_{false};
-    std::atomic<bool> shutdown_{false};
-    StatusCallback statusCallback_;
+    StatusCallback statusCallback_;  // Control thread (start, stop, update)
+    StatusQueue status_;             // Streaming threads; drained into statusCallback_
 };
 
 } // namespace lsltemplate
@@ -0,0 +1,78 @@
+#pragma once
+/**
+ * @file ThreadScheduling.hpp
+ * @brief Real-time scheduling, CPU affinity and memory locking
+ *
+ * Acquisition threads run with the default time-sharing policy unless told
+ * otherwise. On shared machines they can be given a real-time policy, pinned
+ * to CPUs and protected from page faults. Each setting is best effort: one
+ * the process is not allowed to apply (e.g. SCHED_FIFO without CAP_SYS_NICE
+ * or an rtprio limit) is reported and streaming continues without it.
+ */
+
+#include "Device.hpp"
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace lsltemplate {
+
+enum class SchedulingPolicy {
+    Default,     ///< Leave the OS default (SCHED_OTHER)
+    Fifo,        ///< SCHED_FIFO: runs until it blocks or a higher priority preempts it
+    RoundRobin   ///< SCHED_RR: SCHED_FIFO with time slices among equal priorities
+};
+
+/// Parse "default" (or "other", "none"), "fifo" or "rr"
+std::optional<SchedulingPolicy> parseSchedulingPolicy(const std::string& name);
+const char* toString(SchedulingPolicy policy);
+
+/**
+ * @brief How one thread is scheduled
+ */
+struct ThreadScheduling {
+    SchedulingPolicy policy = SchedulingPolicy::Default;
+    int priority = 50;      ///< Real-time priority, 1 (lowest) to 99 on Linux
+    std::vector<int> cpus;  ///< CPUs the thread may run on; empty = any
+
+    bool isDefault() const { return policy == SchedulingPolicy::Default && cpus.empty(); }
+    bool operator==(const ThreadScheduling&) const = default;
+};
+
+/// Parse a CPU list such as "2", "0,2" or "0-3,6"; an empty string is no restriction
+std::optional<std::vector<int>> parseCpuList(const std::string& list);
+
+/// Inverse of parseCpuList(), with ranges collapsed
+std::string formatCpuList(const std::vector<int>& cpus);
+
+/**
+ * @brief Apply scheduling settings to the calling thread
+ * @param scheduling Settings (nothing is changed for the defaults)
+ * @param thread_name Used in the status messages, e.g. "acquisition"
+ * @param callback Told about every setting that could not be applied
+ * @return true if everything was applied
+ */
+bool applyThreadScheduling(const ThreadScheduling& scheduling, const std::string& thread_name,
+                           const StatusCallback& callback);
+
+/**
+ * @brief Lock the process's current and future pages into RAM
+ *
+ * Streaming buffers are allocated and zero-filled before the loops start,
+ * so once locked they never fault. Pages mapped later are locked when
+ * first touched (MCL_ONFAULT), except those of recordings and replayed
+ * files, which are unlocked right after mapping. A memlock limit still has
+ * to leave room for one such mapping while it is set up. Once the memory
+ * is locked, the allocator is also stopped from returning freed memory to
+ * the OS (glibc), so later allocations reuse resident pages. Needs
+ * CAP_IPC_LOCK or a sufficient memlock limit; POSIX systems only.
+ *
+ * @return true if the memory was locked (failures go to callback)
+ */
+bool lockMemory(const StatusCallback& callback);
+
+/// Touch the top 256 KiB of the calling thread's stack so its pages are
+/// resident before the first deadline
+void prefaultStack();
+
+} // namespace lsltemplate
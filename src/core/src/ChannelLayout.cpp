@@ -0,0 +1,111 @@
+#include "lsltemplate/ChannelLayout.hpp"
+#include "MappedFile.hpp"
+#include "TextParsing.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+
+namespace lsltemplate {
+
+namespace {
+
+enum class Column { Label, Unit, Type, X, Y, Z, Ignored };
+
+Column parseColumn(std::string_view name) {
+    std::string lower(trim(name));
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (lower == "label") return Column::Label;
+    if (lower == "unit") return Column::Unit;
+    if (lower == "type") return Column::Type;
+    if (lower == "x") return Column::X;
+    if (lower == "y") return Column::Y;
+    if (lower == "z") return Column::Z;
+    return Column::Ignored;
+}
+
+} // anonymous namespace
+
+ChannelLayout::ChannelLayout(const std::filesystem::path& path) {
+    MappedFile file;
+    if (!file.openReadOnly(path)) {
+        error_ = file.error();
+        return;
+    }
+    std::string_view text(reinterpret_cast<const char*>(file.data()), file.size());
+
+    std::vector<Column> columns;  // Empty until the header row is read
+    std::vector<std::string_view> cells;  // Views into the mapping
+    char delimiter = ',';
+    std::size_t line_number = 0;
+    while (!text.empty()) {
+        const auto newline = text.find('\n');
+        std::string_view line = text.substr(0, newline);
+        text = newline == std::string_view::npos ? std::string_view{} : text.substr(newline + 1);
+        ++line_number;
+        if (trim(line).empty() || trim(line).front() == '#') {
+            continue;
+        }
+
+        cells.clear();
+        if (columns.empty()) {
+            delimiter = line.find('\t') != std::string_view::npos ? '\t' : ',';
+        }
+        while (true) {
+            const auto end = line.find(delimiter);
+            cells.push_back(trim(line.substr(0, end)));
+            if (end == std::string_view::npos) {
+                break;
+            }
+            line.remove_prefix(end + 1);
+        }
+
+        if (columns.empty()) {
+            for (const auto cell : cells) {
+                columns.push_back(parseColumn(cell));
+            }
+            if (std::find(columns.begin(), columns.end(), Column::Label) == columns.end()) {
+                error_ = "Channel layout needs a label column: " + path.string();
+                return;
+            }
+            continue;
+        }
+
+        ChannelDescription channel;
+        std::array<std::string_view, 3> xyz{};
+        for (std::size_t i = 0; i < std::min(cells.size(), columns.size()); ++i) {
+            switch (columns[i]) {
+                case Column::Label: channel.label = cells[i]; break;
+                case Column::Unit: channel.unit = cells[i]; break;
+                case Column::Type: channel.type = cells[i]; break;
+                case Column::X: xyz[0] = cells[i]; break;
+                case Column::Y: xyz[1] = cells[i]; break;
+                case Column::Z: xyz[2] = cells[i]; break;
+                case Column::Ignored: break;
+            }
+        }
+        if (!xyz[0].empty() || !xyz[1].empty() || !xyz[2].empty()) {
+            std::array<double, 3> location{};
+            for (std::size_t i = 0; i < 3; ++i) {
+                const auto value = parseFiniteNumber(xyz[i]);
+                if (!value) {
+                    error_ = "Invalid location on line " + std::to_string(line_number) +
+                        " of " + path.string();
+                    channels_.clear();
+                    return;
+                }
+                location[i] = *value;
+            }
+            channel.location = location;
+        }
+        channels_.push_back(std::move(channel));
+    }
+
+    if (channels_.empty()) {
+        error_ = "Channel layout lists no channels: " + path.string();
+    }
+}
+
+} // namespace lsltemplate
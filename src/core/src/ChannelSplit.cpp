@@ -0,0 +1,140 @@
+#include "lsltemplate/ChannelSplit.hpp"
+#include "TextParsing.hpp"
+#include <cctype>
+
+namespace lsltemplate {
+
+namespace {
+
+std::optional<int> parseIndex(std::string_view text) {
+    text = trim(text);
+    if (text.empty() || text.size() > 6 || !std::all_of(text.begin(), text.end(),
+            [](unsigned char c) { return std::isdigit(c); })) {
+        return std::nullopt;
+    }
+    return std::stoi(std::string(text));
+}
+
+// Metadata of a device channel, labelled by its position in the device
+ChannelDescription channelDescription(const DeviceInfo& info, int channel) {
+    ChannelDescription description;
+    if (static_cast<std::size_t>(channel) < info.channel_layout.size()) {
+        description = info.channel_layout[static_cast<std::size_t>(channel)];
+    }
+    if (description.label.empty()) {
+        description.label = "Ch" + std::to_string(channel + 1);
+    }
+    return description;
+}
+
+} // anonymous namespace
+
+std::optional<std::vector<int>> parseChannelList(std::string_view list) {
+    std::vector<int> channels;
+    while (!trim(list).empty()) {
+        const auto comma = list.find(',');
+        const std::string_view item = trim(list.substr(0, comma));
+        list = comma == std::string_view::npos ? std::string_view{} : list.substr(comma + 1);
+
+        const auto dash = item.find('-');
+        const auto first = parseIndex(item.substr(0, dash));
+        const auto last = dash == std::string_view::npos ? first : parseIndex(item.substr(dash + 1));
+        if (!first || !last) {
+            return std::nullopt;
+        }
+        const int step = *first <= *last ? 1 : -1;
+        for (int channel = *first;; channel += step) {
+            channels.push_back(channel);
+            if (channel == *last) {
+                break;
+            }
+        }
+    }
+    return channels;
+}
+
+std::string formatChannelList(const std::vector<int>& channels) {
+    std::string out;
+    for (std::size_t i = 0; i < channels.size();) {
+        std::size_t j = i;
+        while (j + 1 < channels.size() && channels[j + 1] == channels[j] + 1) {
+            ++j;
+        }
+        if (!out.empty()) {
+            out += ',';
+        }
+        out += std::to_string(channels[i]);
+        if (j > i) {
+            out += '-' + std::to_string(channels[j]);
+        }
+        i = j + 1;
+    }
+    return out;
+}
+
+std::string validateSplits(const std::vector<ChannelSplit>& splits, int channels) {
+    for (std::size_t i = 0; i < splits.size(); ++i) {
+        const auto& split = splits[i];
+        const std::string which = "Split " + (split.name.empty() ? std::to_string(i + 1) : split.name);
+        if (split.channels.empty()) {
+            return which + " has no channels";
+        }
+        for (int channel : split.channels) {
+            if (channel < 0 || channel >= channels) {
+                return which + " uses channel " + std::to_string(channel) + " of a " +
+                    std::to_string(channels) + "-channel device";
+            }
+        }
+        if (!split.labels.empty() && split.labels.size() != split.channels.size()) {
+            return which + " has " + std::to_string(split.labels.size()) + " labels for " +
+                std::to_string(split.channels.size()) + " channels";
+        }
+    }
+    return {};
+}
+
+DeviceInfo splitInfo(const DeviceInfo& parent, const ChannelSplit& split) {
+    DeviceInfo info = parent;
+    info.type = split.type.empty() ? parent.type : split.type;
+    info.name = split.name.empty() ? parent.name + "_" + info.type : split.name;
+    info.source_id = (parent.source_id.empty() ? parent.name : parent.source_id) + "_" + info.name;
+    info.channel_count = static_cast<int>(split.channels.size());
+    info.channel_layout.clear();
+    for (std::size_t i = 0; i < split.channels.size(); ++i) {
+        info.channel_layout.push_back(channelDescription(parent, split.channels[i]));
+        if (i < split.labels.size()) {
+            info.channel_layout.back().label = split.labels[i];
+        }
+    }
+    return info;
+}
+
+ChannelSplitterBase::ChannelSplitterBase(const std::vector<ChannelSplit>& splits,
+                                         std::size_t channels)
+    : in_channels_(channels)
+{
+    for (std::size_t output = 0; output < splits.size(); ++output) {
+        const auto& map = splits[output].channels;
+        out_channels_.push_back(map.size());
+        for (std::size_t target = 0; target < map.size();) {
+            // Extend the run while both sides stay contiguous
+            std::size_t count = 1;
+            while (target + count < map.size() && map[target + count] == map[target] + static_cast<int>(count)) {
+                ++count;
+            }
+            runs_.push_back({
+                static_cast<uint32_t>(output),
+                static_cast<uint32_t>(map[target]),
+                static_cast<uint32_t>(target),
+                static_cast<uint32_t>(count)
+            });
+            target += count;
+        }
+    }
+
+    // Read each device sample front to back
+    std::stable_sort(runs_.begin(), runs_.end(),
+                     [](const Run& a, const Run& b) { return a.source < b.source; });
+}
+
+} // namespace lsltemplate
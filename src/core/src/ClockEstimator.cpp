@@ -0,0 +1,84 @@
+#include "lsltemplate/ClockEstimator.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace lsltemplate {
+
+namespace {
+
+// Initial uncertainty: offset is unknown, slope is close to 1 (clocks tick
+// in seconds). The slope prior is worth roughly ten seconds of observations
+// at ten chunks per second, so early jitter cannot swing it wildly.
+constexpr double kInitialOffsetVariance = 1e6;
+constexpr double kInitialSlopeVariance = 1e-3;
+
+// Smoothing of the reported residual
+constexpr double kJitterSmoothing = 0.01;
+
+} // anonymous namespace
+
+ClockEstimator::ClockEstimator(double forgetting_factor)
+    : lambda_(std::clamp(forgetting_factor, 0.5, 1.0))
+{
+    reset();
+}
+
+void ClockEstimator::reset() {
+    x0_ = 0.0;
+    y0_ = 0.0;
+    intercept_ = 0.0;
+    slope_ = 1.0;
+    p00_ = kInitialOffsetVariance;
+    p01_ = 0.0;
+    p11_ = kInitialSlopeVariance;
+    last_x_ = 0.0;
+    residual_sq_ = 0.0;
+    updates_ = 0;
+}
+
+void ClockEstimator::update(double device_time, double lsl_time) {
+    if (updates_ == 0) {
+        x0_ = device_time;
+        y0_ = lsl_time;
+    }
+
+    const double x = device_time - x0_;
+    const double y = lsl_time - y0_;
+
+    // Regressor phi = [1, x]; gain k = P phi / (lambda + phi' P phi)
+    const double p_phi0 = p00_ + p01_ * x;
+    const double p_phi1 = p01_ + p11_ * x;
+    const double denom = lambda_ + p_phi0 + x * p_phi1;
+    const double k0 = p_phi0 / denom;
+    const double k1 = p_phi1 / denom;
+
+    const double error = y - (intercept_ + slope_ * x);
+    intercept_ += k0 * error;
+    slope_ += k1 * error;
+
+    // P = (P - k phi' P) / lambda
+    p00_ = (p00_ - k0 * p_phi0) / lambda_;
+    p01_ = (p01_ - k0 * p_phi1) / lambda_;
+    p11_ = (p11_ - k1 * p_phi1) / lambda_;
+
+    if (updates_ > 0) {
+        residual_sq_ += kJitterSmoothing * (error * error - residual_sq_);
+    }
+    last_x_ = device_time;
+    ++updates_;
+}
+
+double ClockEstimator::map(double device_time) const {
+    return y0_ + intercept_ + slope_ * (device_time - x0_);
+}
+
+ClockEstimate ClockEstimator::estimate() const {
+    return {
+        .offset = valid() ? map(last_x_) - last_x_ : 0.0,
+        .drift_ppm = (slope_ - 1.0) * 1e6,
+        .jitter = std::sqrt(residual_sq_),
+        .updates = updates_
+    };
+}
+
+} // namespace lsltemplate
@@ -1,8 +1,11 @@
 #include "lsltemplate/Config.hpp"
+#include "TextParsing.hpp"
 #include <fstream>
 #include <sstream>
 #include <algorithm>
 #include <cctype>
+#include <map>
+#include <stdexcept>
 #include <vector>
 
 #ifdef _WIN32
@@ -22,13 +25,11 @@ namespace lsltemplate {
 
 namespace {
 
-// Simple INI parser helpers
-std::string trim(const std::string& str) {
-    auto start = std::find_if_not(str.begin(), str.end(),
-        [](unsigned char c) { return std::isspace(c); });
-    auto end = std::find_if_not(str.rbegin(), str.rend(),
-        [](unsigned char c) { return std::isspace(c); }).base();
-    return (start < end) ? std::string(start, end) : std::string();
+bool parseBool(const std::string& value) {
+    std::string lower = value;
+    std::transform(lower.begin(), lower.end(), lower.begin(),
+        [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return lower == "1" || lower == "true" || lower == "yes" || lower == "on";
 }
 
 std::filesystem::path getExecutablePath() {
@@ -81,20 +82,207 @@ std::filesystem::path getConfigDirectory() {
 #endif
 }
 
-} // anonymous namespace
+// Map one key to its config field (customize for your application)
+void applyKey(AppConfig& config, const std::string& key, const std::string& value) {
+    // Real-time keys are prefixed with the thread they apply to
+    auto scheduling = [&](const std::string& name) -> ThreadScheduling& {
+        return name.starts_with("publisher_")
+            ? config.publisher_scheduling : config.acquisition_scheduling;
+    };
+
+    if (key == "name" || key == "stream_name") {
+        config.stream_name = value;
+    } else if (key == "type" || key == "stream_type") {
+        config.stream_type = value;
+    } else if (key == "channels" || key == "channel_count") {
+        config.channel_count = std::stoi(value);
+    } else if (key == "sample_rate" || key == "srate") {
+        config.sample_rate = std::stod(value);
+    } else if (key == "format" || key == "channel_format") {
+        const auto format = parseSampleFormat(value);
+        if (!format) {
+            throw std::invalid_argument(key);  // Reported by applyKeyChecked()
+        }
+        config.sample_format = *format;
+    } else if (key == "channel_layout") {
+        config.channel_layout = value;
+    } else if (key == "device" || key == "device_param") {
+        config.device_param = std::stoi(value);
+    } else if (key == "waveform") {
+        config.waveform = (value == "none") ? std::string() : value;
+    } else if (key == "amplitude") {
+        config.amplitude = value;
+    } else if (key == "frequency") {
+        config.frequency = value;
+    } else if (key == "phase") {
+        config.phase = value;
+    } else if (key == "chirp_end") {
+        config.chirp_end = value;
+    } else if (key == "chirp_period") {
+        config.chirp_period = std::stod(value);
+    } else if (key == "seed") {
+        config.seed = std::stoull(value);
+    } else if (key == "device_clock") {
+        config.device_clock = parseBool(value);
+    } else if (key == "clock_drift_ppm") {
+        config.clock_drift_ppm = std::stod(value);
+    } else if (key == "replay") {
+        config.replay = value;
+    } else if (key == "replay_speed") {
+        config.replay_speed = value == "max" ? 0.0 : std::stod(value);
+    } else if (key == "replay_loop") {
+        config.replay_loop = parseBool(value);
+    } else if (key == "reconnect") {
+        config.reconnect = parseBool(value);
+    } else if (key == "reconnect_delay") {
+        config.reconnect_delay = std::stod(value);
+    } else if (key == "reconnect_max_delay") {
+        config.reconnect_max_delay = std::stod(value);
+    } else if (key == "reconnect_timeout") {
+        config.reconnect_timeout = std::stod(value);
+    } else if (key == "rate_window") {
+        config.rate_window = std::stod(value);
+    } else if (key == "rate_tolerance") {
+        config.rate_tolerance = std::stod(value);
+    } else if (key == "stall_factor") {
+        config.stall_factor = std::stod(value);
+    } else if (key == "filters") {
+        config.filters = (value == "none") ? std::string() : value;
+    } else if (key == "decimate") {
+        config.decimate = (value == "none") ? std::string() : value;
+    } else if (key == "chunk_duration") {
+        config.chunk_duration = std::stod(value);
+    } else if (key == "max_buffered") {
+        config.max_buffered = std::stoi(value);
+    } else if (key == "adaptive_chunk") {
+        config.adaptive_chunk = parseBool(value);
+    } else if (key == "latency_target") {
+        config.latency_target = std::stod(value);
+    } else if (key == "cpu_budget") {
+        config.cpu_budget = std::stod(value);
+    } else if (key == "decoupled") {
+        config.decoupled = parseBool(value);
+    } else if (key == "ring_capacity") {
+        const int capacity = std::stoi(value);
+        if (capacity < 1) {
+            throw std::out_of_range("ring_capacity");  // Reported by applyKeyChecked()
+        }
+        config.ring_capacity = capacity;
+    } else if (key == "dejitter") {
+        config.dejitter = parseBool(value);
+    } else if (key == "pace") {
+        config.pace = parseBool(value);
+    } else if (key == "pacing_spin_us") {
+        config.pacing_spin_us = std::stoi(value);
+    } else if (key == "gate_on_consumers") {
+        config.gate_on_consumers = parseBool(value);
+    } else if (key == "preroll") {
+        config.preroll = std::stod(value);
+    } else if (key == "record") {
+        config.record = value;
+    } else if (key == "record_segment_mb") {
+        config.record_segment_mb = std::stoi(value);
+    } else if (key == "stats_interval") {
+        config.stats_interval = std::stod(value);
+    } else if (key == "acquisition_policy" || key == "publisher_policy") {
+        const auto policy = parseSchedulingPolicy(value);
+        if (!policy) {
+            throw std::invalid_argument(key);
+        }
+        scheduling(key).policy = *policy;
+    } else if (key == "acquisition_priority" || key == "publisher_priority") {
+        scheduling(key).priority = std::stoi(value);
+    } else if (key == "acquisition_cpus" || key == "publisher_cpus") {
+        auto cpus = parseCpuList(value);
+        if (!cpus) {
+            throw std::invalid_argument(key);
+        }
+        scheduling(key).cpus = std::move(*cpus);
+    } else if (key == "lock_memory") {
+        config.lock_memory = parseBool(value);
+    } else if (key == "overflow_policy") {
+        const auto policy = parseOverflowPolicy(value);
+        if (!policy) {
+            throw std::invalid_argument(key);
+        }
+        config.overflow_policy = *policy;
+    }
+}
+
+// applyKey() that reports unparseable numbers instead of throwing, so a
+// half-edited file is rejected as a whole rather than ending the process
+bool applyKeyChecked(AppConfig& config, const std::string& key, const std::string& value,
+                     std::string& error) {
+    try {
+        applyKey(config, key, value);
+        return true;
+    } catch (const std::logic_error&) {  // std::invalid_argument, std::out_of_range
+        error = "Invalid value for " + key + ": '" + value + "'";
+        return false;
+    }
+}
+
+// Index of a per-stream section such as [Stream.2] or [Device.2]
+std::optional<int> streamIndex(const std::string& section) {
+    const auto dot = section.rfind('.');
+    if (dot == std::string::npos || dot + 1 == section.size()) {
+        return std::nullopt;
+    }
+    const std::string suffix = section.substr(dot + 1);
+    if (suffix.size() > 9 || !std::all_of(suffix.begin(), suffix.end(),
+            [](unsigned char c) { return std::isdigit(c); })) {
+        return std::nullopt;
+    }
+    return std::stoi(suffix);
+}
+
+// Index of a channel split section such as [Split.1]
+std::optional<int> splitIndex(const std::string& section) {
+    if (section.rfind("Split.", 0) != 0) {
+        return std::nullopt;
+    }
+    return streamIndex(section);
+}
+
+void applySplitKey(ChannelSplit& split, const std::string& key, const std::string& value) {
+    if (key == "name") {
+        split.name = value;
+    } else if (key == "type") {
+        split.type = value;
+    } else if (key == "channels") {
+        // Unparseable lists leave the split empty, which start() reports
+        split.channels = parseChannelList(value).value_or(std::vector<int>{});
+    } else if (key == "labels") {
+        split.labels.clear();
+        std::istringstream labels(value);
+        std::string label;
+        while (std::getline(labels, label, ',')) {
+            split.labels.emplace_back(trim(label));
+        }
+    }
+}
 
-std::optional<AppConfig> ConfigManager::load(const std::filesystem::path& path) {
+struct ParsedFile {
+    AppConfig defaults;
+    // Per-stream key/value overrides by section index
+    std::map<int, std::vector<std::pair<std::string, std::string>>> streams;
+};
+
+std::optional<ParsedFile> parseFile(const std::filesystem::path& path, std::string& error) {
     std::ifstream file(path);
     if (!file.is_open()) {
+        error = "Cannot open " + path.string();
         return std::nullopt;
     }
 
-    AppConfig config;
+    ParsedFile parsed;
     std::string line;
-    std::string current_section;
+    std::optional<int> current_stream;
+    std::optional<int> current_split;
+    std::map<int, ChannelSplit> splits;
 
     while (std::getline(file, line)) {
-        line = trim(line);
+        line = std::string(trim(line));
 
         // Skip empty lines and comments
         if (line.empty() || line[0] == '#' || line[0] == ';') {
@@ -103,37 +291,88 @@ std::optional<AppConfig> ConfigManager::load(const std::filesystem::path& path)
 
         // Section header
         if (line.front() == '[' && line.back() == ']') {
-            current_section = line.substr(1, line.size() - 2);
+            const std::string section = line.substr(1, line.size() - 2);
+            current_split = splitIndex(section);
+            current_stream = current_split ? std::nullopt : streamIndex(section);
+            if (current_split) {
+                splits[*current_split];
+            } else if (current_stream) {
+                parsed.streams[*current_stream];
+            }
             continue;
         }
 
         // Key=value pair
         auto eq_pos = line.find('=');
         if (eq_pos != std::string::npos) {
-            std::string key = trim(line.substr(0, eq_pos));
-            std::string value = trim(line.substr(eq_pos + 1));
+            std::string key(trim(std::string_view(line).substr(0, eq_pos)));
+            std::string value(trim(std::string_view(line).substr(eq_pos + 1)));
 
             // Remove quotes if present
             if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
                 value = value.substr(1, value.size() - 2);
             }
 
-            // Map to config fields (customize for your application)
-            if (key == "name" || key == "stream_name") {
-                config.stream_name = value;
-            } else if (key == "type" || key == "stream_type") {
-                config.stream_type = value;
-            } else if (key == "channels" || key == "channel_count") {
-                config.channel_count = std::stoi(value);
-            } else if (key == "sample_rate" || key == "srate") {
-                config.sample_rate = std::stod(value);
-            } else if (key == "device" || key == "device_param") {
-                config.device_param = std::stoi(value);
+            if (current_split) {
+                applySplitKey(splits[*current_split], key, value);
+            } else if (current_stream) {
+                parsed.streams[*current_stream].emplace_back(std::move(key), std::move(value));
+            } else if (!applyKeyChecked(parsed.defaults, key, value, error)) {
+                return std::nullopt;
             }
         }
     }
 
-    return config;
+    for (auto& [index, split] : splits) {
+        parsed.defaults.splits.push_back(std::move(split));
+    }
+    return parsed;
+}
+
+} // anonymous namespace
+
+std::optional<AppConfig> ConfigManager::load(const std::filesystem::path& path, std::string* error) {
+    std::string message;
+    auto parsed = parseFile(path, message);
+    if (!parsed) {
+        if (error) {
+            *error = message;
+        }
+        return std::nullopt;
+    }
+    return parsed->defaults;
+}
+
+std::optional<std::vector<AppConfig>> ConfigManager::loadAll(const std::filesystem::path& path,
+                                                             std::string* error) {
+    std::string message;
+    auto parsed = parseFile(path, message);
+    if (!parsed) {
+        if (error) {
+            *error = message;
+        }
+        return std::nullopt;
+    }
+    if (parsed->streams.empty()) {
+        return std::vector<AppConfig>{parsed->defaults};
+    }
+
+    // Each stream starts from the unnumbered sections, then applies its own
+    std::vector<AppConfig> configs;
+    configs.reserve(parsed->streams.size());
+    for (const auto& [index, overrides] : parsed->streams) {
+        AppConfig config = parsed->defaults;
+        for (const auto& [key, value] : overrides) {
+            if (!applyKeyChecked(config, key, value, message)) {
+                if (error) {
+                    *error = "[" + std::to_string(index) + "] " + message;
+                }
+                return std::nullopt;
+            }
+        }
+        configs.push_back(std::move(config));
+    }
+    return configs;
 }
 
 bool ConfigManager::save(const AppConfig& config, const std::filesystem::path& path) {
@@ -148,9 +387,75 @@ bool ConfigManager::save(const AppConfig& config, const std::filesystem::path& p
     file << "type=" << config.stream_type << "\n";
     file << "channels=" << config.channel_count << "\n";
     file << "sample_rate=" << config.sample_rate << "\n";
+    file << "format=" << toString(config.sample_format) << "\n";
+    file << "channel_layout=" << config.channel_layout << "\n";
     file << "\n";
     file << "[Device]\n";
     file << "device_param=" << config.device_param << "\n";
+    file << "waveform=" << (config.waveform.empty() ? "none" : config.waveform) << "\n";
+    file << "amplitude=" << config.amplitude << "\n";
+    file << "frequency=" << config.frequency << "\n";
+    file << "phase=" << config.phase << "\n";
+    file << "chirp_end=" << config.chirp_end << "\n";
+    file << "chirp_period=" << config.chirp_period << "\n";
+    file << "seed=" << config.seed << "\n";
+    file << "device_clock=" << (config.device_clock ? "true" : "false") << "\n";
+    file << "clock_drift_ppm=" << config.clock_drift_ppm << "\n";
+    file << "replay=" << config.replay << "\n";
+    file << "replay_speed=" << config.replay_speed << "\n";
+    file << "replay_loop=" << (config.replay_loop ? "true" : "false") << "\n";
+    file << "reconnect=" << (config.reconnect ? "true" : "false") << "\n";
+    file << "reconnect_delay=" << config.reconnect_delay << "\n";
+    file << "reconnect_max_delay=" << config.reconnect_max_delay << "\n";
+    file << "reconnect_timeout=" << config.reconnect_timeout << "\n";
+    file << "rate_window=" << config.rate_window << "\n";
+    file << "rate_tolerance=" << config.rate_tolerance << "\n";
+    file << "stall_factor=" << config.stall_factor << "\n";
+    file << "\n";
+    file << "[Filters]\n";
+    file << "filters=" << (config.filters.empty() ? "none" : config.filters) << "\n";
+    file << "decimate=" << (config.decimate.empty() ? "none" : config.decimate) << "\n";
+    file << "\n";
+    file << "[Pipeline]\n";
+    file << "chunk_duration=" << config.chunk_duration << "\n";
+    file << "max_buffered=" << config.max_buffered << "\n";
+    file << "adaptive_chunk=" << (config.adaptive_chunk ? "true" : "false") << "\n";
+    file << "latency_target=" << config.latency_target << "\n";
+    file << "cpu_budget=" << config.cpu_budget << "\n";
+    file << "decoupled=" << (config.decoupled ? "true" : "false") << "\n";
+    file << "ring_capacity=" << config.ring_capacity << "\n";
+    file << "overflow_policy=" << toString(config.overflow_policy) << "\n";
+    file << "dejitter=" << (config.dejitter ? "true" : "false") << "\n";
+    file << "pace=" << (config.pace ? "true" : "false") << "\n";
+    file << "pacing_spin_us=" << config.pacing_spin_us << "\n";
+    file << "gate_on_consumers=" << (config.gate_on_consumers ? "true" : "false") << "\n";
+    file << "preroll=" << config.preroll << "\n";
+    file << "record=" << config.record << "\n";
+    file << "record_segment_mb=" << config.record_segment_mb << "\n";
+    file << "stats_interval=" << config.stats_interval << "\n";
+    file << "\n";
+    file << "[Realtime]\n";
+    file << "acquisition_policy=" << toString(config.acquisition_scheduling.policy) << "\n";
+    file << "acquisition_priority=" << config.acquisition_scheduling.priority << "\n";
+    file << "acquisition_cpus=" << formatCpuList(config.acquisition_scheduling.cpus) << "\n";
+    file << "publisher_policy=" << toString(config.publisher_scheduling.policy) << "\n";
+    file << "publisher_priority=" << config.publisher_scheduling.priority << "\n";
+    file << "publisher_cpus=" << formatCpuList(config.publisher_scheduling.cpus) << "\n";
+    file << "lock_memory=" << (config.lock_memory ? "true" : "false") << "\n";
+
+    for (std::size_t i = 0; i < config.splits.size(); ++i) {
+        const auto& split = config.splits[i];
+        file << "\n";
+        file << "[Split." << (i + 1) << "]\n";
+        file << "name=" << split.name << "\n";
+        file << "type=" << split.type << "\n";
+        file << "channels=" << formatChannelList(split.channels) << "\n";
+        file << "labels=";
+        for (std::size_t c = 0; c < split.labels.size(); ++c) {
+            file << (c > 0 ? "," : "") << split.labels[c];
+        }
+        file << "\n";
+    }
 
     return file.good();
 }
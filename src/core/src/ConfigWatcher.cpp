@@ -0,0 +1,176 @@
+#include "lsltemplate/ConfigWatcher.hpp"
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <system_error>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace lsltemplate {
+
+namespace {
+
+// Longest the watcher thread sleeps before checking for shutdown
+constexpr auto kWakeInterval = std::chrono::milliseconds(100);
+
+// What polling compares; nullopt while the file does not exist
+struct FileStamp {
+    std::filesystem::file_time_type modified;
+    std::uintmax_t size = 0;
+
+    bool operator==(const FileStamp&) const = default;
+};
+
+std::optional<FileStamp> stamp(const std::filesystem::path& path) {
+    std::error_code error;
+    const auto modified = std::filesystem::last_write_time(path, error);
+    if (error) {
+        return std::nullopt;
+    }
+    const auto size = std::filesystem::file_size(path, error);
+    if (error) {
+        return std::nullopt;
+    }
+    return FileStamp{modified, size};
+}
+
+} // anonymous namespace
+
+ConfigWatcher::ConfigWatcher(const std::filesystem::path& path, ChangeCallback on_change,
+                             StatusCallback callback)
+    : ConfigWatcher(path, Config{}, std::move(on_change), std::move(callback))
+{
+}
+
+ConfigWatcher::ConfigWatcher(const std::filesystem::path& path, const Config& config,
+                             ChangeCallback on_change, StatusCallback callback)
+    : path_(std::filesystem::absolute(path))
+    , config_(config)
+    , on_change_(std::move(on_change))
+    , statusCallback_(std::move(callback))
+{
+}
+
+ConfigWatcher::~ConfigWatcher() {
+    stop();
+}
+
+bool ConfigWatcher::start() {
+    if (thread_.joinable()) {
+        return false;
+    }
+    shutdown_ = false;
+
+#ifdef __linux__
+    if (!config_.force_polling) {
+        // The directory, not the file: saving by rename replaces the inode
+        int error = 0;
+        inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (inotify_fd_ < 0) {
+            error = errno;
+        } else if (inotify_add_watch(inotify_fd_, path_.parent_path().c_str(),
+                                     IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE) < 0) {
+            error = errno;
+            close(inotify_fd_);
+            inotify_fd_ = -1;
+        }
+        if (error != 0 && statusCallback_) {
+            statusCallback_(std::string("inotify unavailable (") + std::strerror(error) +
+                            "), polling instead", true);
+        }
+    }
+    if (inotify_fd_ >= 0) {
+        thread_ = std::thread(&ConfigWatcher::watchInotify, this);
+    } else
+#endif
+    {
+        thread_ = std::thread(&ConfigWatcher::watchPolling, this);
+    }
+
+    if (statusCallback_) {
+        statusCallback_("Watching " + path_.string() + " (" + backend() + ")", false);
+    }
+    return true;
+}
+
+void ConfigWatcher::stop() {
+    if (!thread_.joinable()) {
+        return;
+    }
+    shutdown_ = true;
+    thread_.join();
+#ifdef __linux__
+    if (inotify_fd_ >= 0) {
+        close(inotify_fd_);
+        inotify_fd_ = -1;
+    }
+#endif
+}
+
+void ConfigWatcher::watchInotify() {
+#ifdef __linux__
+    const std::string name = path_.filename().string();
+    alignas(inotify_event) char buffer[4096];
+    bool changed = false;
+    std::chrono::steady_clock::time_point changed_at;  // Last relevant event
+
+    while (!shutdown_) {
+        pollfd fd{inotify_fd_, POLLIN, 0};
+        if (poll(&fd, 1, static_cast<int>(kWakeInterval.count())) > 0) {
+            ssize_t length;
+            while ((length = read(inotify_fd_, buffer, sizeof(buffer))) > 0) {
+                for (char* p = buffer; p < buffer + length;) {
+                    const auto* event = reinterpret_cast<const inotify_event*>(p);
+                    if (event->len > 0 && name == event->name) {
+                        changed = true;
+                        changed_at = std::chrono::steady_clock::now();
+                    }
+                    p += sizeof(inotify_event) + event->len;
+                }
+            }
+        }
+
+        if (changed && std::chrono::steady_clock::now() - changed_at >= config_.settle) {
+            changed = false;
+            if (std::filesystem::exists(path_) && on_change_) {
+                on_change_();
+            }
+        }
+    }
+#endif
+}
+
+void ConfigWatcher::watchPolling() {
+    auto last = stamp(path_);
+    bool changed = false;
+    std::chrono::steady_clock::time_point changed_at;
+    auto next_poll = std::chrono::steady_clock::now();
+
+    while (!shutdown_) {
+        std::this_thread::sleep_for(kWakeInterval);
+        const auto now = std::chrono::steady_clock::now();
+        if (now < next_poll) {
+            continue;
+        }
+        next_poll = now + config_.poll_interval;
+
+        const auto current = stamp(path_);
+        if (current != last) {
+            last = current;
+            changed = true;
+            changed_at = now;
+        } else if (changed && current && now - changed_at >= config_.settle) {
+            changed = false;
+            if (on_change_) {
+                on_change_();
+            }
+        }
+    }
+}
+
+} // namespace lsltemplate
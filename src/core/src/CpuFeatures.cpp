@@ -0,0 +1,43 @@
+#include "CpuFeatures.hpp"
+#include <cstdlib>
+#include <cstring>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace lsltemplate::simd {
+
+bool cpuHasAvx2Fma() {
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    int regs[4];
+    __cpuid(regs, 1);
+    const bool fma = (regs[2] & (1 << 12)) != 0;
+    const bool osxsave = (regs[2] & (1 << 27)) != 0;
+    const bool avx = (regs[2] & (1 << 28)) != 0;
+    if (!fma || !osxsave || !avx) {
+        return false;
+    }
+    // The OS must save the upper YMM state on context switches
+    if ((_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+    __cpuidex(regs, 7, 0);
+    return (regs[1] & (1 << 5)) != 0;
+#else
+    return false;
+#endif
+}
+
+bool simdEnabled() {
+    static const bool enabled = [] {
+        const char* value = std::getenv("LSLTEMPLATE_SIMD");
+        return !(value && std::strcmp(value, "scalar") == 0);
+    }();
+    return enabled;
+}
+
+} // namespace lsltemplate::simd
@@ -0,0 +1,20 @@
+#pragma once
+/**
+ * @file CpuFeatures.hpp
+ * @brief Runtime instruction-set detection for kernel dispatch (private)
+ */
+
+namespace lsltemplate::simd {
+
+/// True if the CPU and OS support AVX2 and FMA
+bool cpuHasAvx2Fma();
+
+/**
+ * @brief Whether vector kernels may be used
+ *
+ * Setting the environment variable LSLTEMPLATE_SIMD=scalar forces the scalar
+ * kernels, e.g. to compare throughput or rule out a kernel bug.
+ */
+bool simdEnabled();
+
+} // namespace lsltemplate::simd
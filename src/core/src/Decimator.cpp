@@ -0,0 +1,93 @@
+#include "lsltemplate/Decimator.hpp"
+#include <cctype>
+#include <cmath>
+#include <numbers>
+#include <numeric>
+
+namespace lsltemplate {
+
+namespace {
+
+// Blackman window: transition width ~5.5 / taps of the input rate
+constexpr double kBlackmanTransition = 5.5;
+
+// Transition band as a fraction of the output rate (+-20% of its Nyquist)
+constexpr double kTransition = 0.2;
+
+} // anonymous namespace
+
+std::vector<double> designDecimationFilter(std::size_t factor) {
+    factor = std::max<std::size_t>(1, factor);
+    if (factor == 1) {
+        return {1.0};
+    }
+
+    // Odd length, so the group delay is a whole number of input samples
+    const double width = kTransition / static_cast<double>(factor);
+    std::size_t taps = static_cast<std::size_t>(std::ceil(kBlackmanTransition / width));
+    taps |= 1;
+
+    const double cutoff = 0.5 / static_cast<double>(factor);  // Cycles per input sample
+    const double middle = static_cast<double>(taps - 1) / 2.0;
+    std::vector<double> h(taps);
+    for (std::size_t n = 0; n < taps; ++n) {
+        const double x = static_cast<double>(n) - middle;
+        const double sinc = x == 0.0
+            ? 2.0 * cutoff
+            : std::sin(2.0 * std::numbers::pi * cutoff * x) / (std::numbers::pi * x);
+        const double phase = 2.0 * std::numbers::pi * static_cast<double>(n) /
+                             static_cast<double>(taps - 1);
+        const double window = 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase);
+        h[n] = sinc * window;
+    }
+
+    // Unity gain at DC
+    const double sum = std::accumulate(h.begin(), h.end(), 0.0);
+    for (auto& tap : h) {
+        tap /= sum;
+    }
+    return h;
+}
+
+std::optional<std::vector<std::size_t>> parseDecimation(std::string_view list) {
+    std::vector<std::size_t> factors;
+    std::size_t begin = 0;
+    while (begin <= list.size()) {
+        const auto comma = std::min(list.find(',', begin), list.size());
+        std::string_view item = list.substr(begin, comma - begin);
+        begin = comma + 1;
+
+        while (!item.empty() && std::isspace(static_cast<unsigned char>(item.front()))) {
+            item.remove_prefix(1);
+        }
+        while (!item.empty() && std::isspace(static_cast<unsigned char>(item.back()))) {
+            item.remove_suffix(1);
+        }
+        if (item.empty()) {
+            continue;
+        }
+        if (item.size() > 6 || !std::all_of(item.begin(), item.end(),
+                [](unsigned char c) { return std::isdigit(c); })) {
+            return std::nullopt;
+        }
+        const auto factor = static_cast<std::size_t>(std::stoul(std::string(item)));
+        if (factor < 2) {
+            return std::nullopt;
+        }
+        factors.push_back(factor);
+    }
+    return factors;
+}
+
+std::string formatDecimation(const std::vector<std::size_t>& factors) {
+    std::string out;
+    for (std::size_t factor : factors) {
+        if (!out.empty()) {
+            out += ',';
+        }
+        out += std::to_string(factor);
+    }
+    return out;
+}
+
+} // namespace lsltemplate
@@ -1,9 +1,42 @@
 #include "lsltemplate/Device.hpp"
-#include <chrono>
-#include <thread>
+#include <algorithm>
+#include <cmath>
 
 namespace lsltemplate {
 
+// =============================================================================
+// IDevice defaults - formats a device does not produce natively
+// =============================================================================
+
+bool IDevice::getData(std::vector<float>&) { return false; }
+bool IDevice::getData(std::vector<double>&) { return false; }
+bool IDevice::getData(std::vector<int64_t>&) { return false; }
+bool IDevice::getData(std::vector<int32_t>&) { return false; }
+bool IDevice::getData(std::vector<int16_t>&) { return false; }
+bool IDevice::getData(std::vector<int8_t>&) { return false; }
+bool IDevice::getData(std::vector<std::string>&) { return false; }
+
+// The span overloads fall back to the legacy vector overloads
+std::size_t IDevice::getData(std::span<float> out, double&) { return readLegacy(out); }
+std::size_t IDevice::getData(std::span<double> out, double&) { return readLegacy(out); }
+std::size_t IDevice::getData(std::span<int64_t> out, double&) { return readLegacy(out); }
+std::size_t IDevice::getData(std::span<int32_t> out, double&) { return readLegacy(out); }
+std::size_t IDevice::getData(std::span<int16_t> out, double&) { return readLegacy(out); }
+std::size_t IDevice::getData(std::span<int8_t> out, double&) { return readLegacy(out); }
+std::size_t IDevice::getData(std::span<std::string> out, double&) { return readLegacy(out); }
+
+template <typename T>
+std::size_t IDevice::readLegacy(std::span<T> out) {
+    // One scratch buffer per acquisition thread; sized once, then reused
+    thread_local std::vector<T> scratch;
+    scratch.resize(out.size());
+    if (!getData(scratch)) {
+        return kReadError;
+    }
+    std::move(scratch.begin(), scratch.end(), out.begin());
+    return out.size() / static_cast<std::size_t>(std::max(1, getInfo().channel_count));
+}
+
 // =============================================================================
 // MockDevice Implementation
 // =============================================================================
@@ -11,7 +44,17 @@ namespace lsltemplate {
 MockDevice::MockDevice(const Config& config)
     : config_(config)
     , counter_(config.start_value)
+    , pacer_({.rate = config.sample_rate, .spin = config.pacing_spin})
 {
+    if (!config_.signals.empty()) {
+        generator_ = std::make_unique<SignalGenerator>(SignalGenerator::Config{
+            .channel_count = config_.channel_count,
+            .sample_rate = config_.sample_rate,
+            .channels = config_.signals,
+            .chirp_period = config_.chirp_period,
+            .seed = config_.seed
+        });
+    }
 }
 
 MockDevice::~MockDevice() {
@@ -22,6 +65,11 @@ bool MockDevice::connect() {
     // In a real implementation, initialize hardware connection here
     connected_ = true;
     counter_ = config_.start_value;
+    samples_generated_ = 0;
+    pacer_.reset();
+    if (generator_) {
+        generator_->reset();
+    }
     return true;
 }
 
@@ -39,34 +87,85 @@ DeviceInfo MockDevice::getInfo() const {
         .type = config_.type,
         .channel_count = config_.channel_count,
         .sample_rate = config_.sample_rate,
-        .source_id = config_.name + "_mock"
+        .source_id = config_.name + "_mock",
+        .format = config_.format,
+        .timestamp_clock = config_.device_clock ? TimestampClock::Device : TimestampClock::Lsl,
+        .channel_layout = {}
     };
 }
 
-bool MockDevice::getData(std::vector<float>& buffer) {
-    if (!connected_) {
-        return false;
+std::size_t MockDevice::getData(std::span<float> out, double& timestamp) { return generate(out, timestamp); }
+std::size_t MockDevice::getData(std::span<double> out, double& timestamp) { return generate(out, timestamp); }
+std::size_t MockDevice::getData(std::span<int64_t> out, double& timestamp) { return generate(out, timestamp); }
+std::size_t MockDevice::getData(std::span<int32_t> out, double& timestamp) { return generate(out, timestamp); }
+std::size_t MockDevice::getData(std::span<int16_t> out, double& timestamp) { return generate(out, timestamp); }
+std::size_t MockDevice::getData(std::span<int8_t> out, double& timestamp) { return generate(out, timestamp); }
+std::size_t MockDevice::getData(std::span<std::string> out, double& timestamp) { return generate(out, timestamp); }
+
+bool MockDevice::setParameter(int value) {
+    config_.start_value = value;
+    counter_ = value;
+    return true;
+}
+
+template <typename T>
+std::size_t MockDevice::generate(std::span<T> out, double& timestamp) {
+    // Only the configured format is produced, like a real device would
+    if (!connected_ || sampleFormatOf<T>() != config_.format) {
+        return kReadError;
     }
 
     // Calculate samples based on buffer size and channel count
-    const size_t samples_requested = buffer.size() / config_.channel_count;
+    size_t samples_requested = out.size() / config_.channel_count;
+    if (!config_.blocking && config_.sample_rate > 0) {
+        samples_requested = std::min<size_t>(samples_requested, pacer_.available());
+    }
 
-    // Generate synthetic data
-    for (size_t i = 0; i < buffer.size(); ++i) {
-        buffer[i] = static_cast<float>(counter_++);
+    const size_t values = samples_requested * config_.channel_count;
+
+    if (generator_) {
+        // Synthetic waveforms are produced as float; other formats convert
+        if constexpr (std::is_same_v<T, float>) {
+            generator_->generate(out.first(values));
+        } else {
+            scratch_.resize(values);
+            generator_->generate(scratch_);
+            for (size_t i = 0; i < values; ++i) {
+                if constexpr (std::is_same_v<T, std::string>) {
+                    out[i] = std::to_string(scratch_[i]);
+                } else if constexpr (std::is_floating_point_v<T>) {
+                    out[i] = static_cast<T>(scratch_[i]);
+                } else {
+                    out[i] = static_cast<T>(std::lround(scratch_[i]));
+                }
+            }
+        }
+    } else {
+        // Generate synthetic data (integer formats wrap around)
+        for (size_t i = 0; i < values; ++i) {
+            if constexpr (std::is_same_v<T, std::string>) {
+                out[i] = std::to_string(counter_++);
+            } else {
+                out[i] = static_cast<T>(counter_++);
+            }
+        }
     }
 
-    // Simulate real-time acquisition by sleeping
-    if (config_.sample_rate > 0) {
-        const auto sample_period = std::chrono::duration<double>(
-            samples_requested / config_.sample_rate
-        );
-        std::this_thread::sleep_for(
-            std::chrono::duration_cast<std::chrono::milliseconds>(sample_period)
-        );
+    // Simulate real-time acquisition: wait until the last sample is due
+    if (config_.blocking) {
+        pacer_.wait(samples_requested, stopToken());
+    } else {
+        pacer_.advance(samples_requested);
     }
 
-    return true;
+    // Simulated hardware clock: sample index times the (drifting) period
+    samples_generated_ += samples_requested;
+    if (config_.device_clock && config_.sample_rate > 0 && samples_requested > 0) {
+        timestamp = static_cast<double>(samples_generated_ - 1) / config_.sample_rate *
+            (1.0 + config_.clock_drift_ppm * 1e-6);
+    }
+
+    return samples_requested;
 }
 
 } // namespace lsltemplate
@@ -0,0 +1,375 @@
+#include "lsltemplate/FileReplayDevice.hpp"
+#include "MappedFile.hpp"
+#include "RecordingFormat.hpp"
+#include "TextParsing.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+
+namespace lsltemplate {
+
+namespace {
+
+// Longest a blocking read sleeps waiting for the next chunk
+constexpr auto kMaxWait = std::chrono::milliseconds(100);
+
+// Device time of the first sample; never the "not stamped" value 0.0
+constexpr double kReplayEpoch = 1.0;
+
+template <typename V>
+V readValue(const std::byte* data) {
+    V value;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+// Recorder segments after `path`, if its name ends in _NNNN
+std::vector<std::filesystem::path> segmentSequence(const std::filesystem::path& path) {
+    std::vector<std::filesystem::path> paths{path};
+    const std::string stem = path.stem().string();
+    if (stem.size() < 5 || stem[stem.size() - 5] != '_' ||
+        !std::all_of(stem.end() - 4, stem.end(), [](char c) { return std::isdigit(static_cast<unsigned char>(c)); })) {
+        return paths;
+    }
+    const std::string prefix = stem.substr(0, stem.size() - 4);
+    for (int index = std::stoi(stem.substr(stem.size() - 4)) + 1; index <= 9999; ++index) {
+        std::ostringstream name;
+        name << prefix << std::setw(4) << std::setfill('0') << index << path.extension().string();
+        const auto next = path.parent_path() / name.str();
+        if (!std::filesystem::exists(next)) {
+            break;
+        }
+        paths.push_back(next);
+    }
+    return paths;
+}
+
+} // anonymous namespace
+
+FileReplayDevice::FileReplayDevice(const Config& config)
+    : config_(config)
+{
+    std::string extension = config_.path.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+    if (extension == ".csv" ? loadCsv() : loadRecording()) {
+        finishIndex();
+    }
+}
+
+FileReplayDevice::~FileReplayDevice() {
+    disconnect();
+}
+
+bool FileReplayDevice::fail(const std::string& message) {
+    error_ = message;
+    blocks_.clear();
+    return false;
+}
+
+bool FileReplayDevice::loadRecording() {
+    using namespace recording;
+
+    uint64_t sample = 0;
+    for (const auto& path : segmentSequence(config_.path)) {
+        auto file = std::make_unique<MappedFile>();
+        if (!file->openReadOnly(path)) {
+            return fail(file->error());
+        }
+        const std::byte* data = file->data();
+        const std::size_t size = file->size();
+        if (size < kFixedHeaderBytes || std::memcmp(data, kMagic, sizeof(kMagic)) != 0) {
+            return fail("Not a recording: " + path.string());
+        }
+
+        const auto header_bytes = readValue<uint32_t>(data + 8);
+        const auto format = readValue<uint32_t>(data + 12);
+        const auto channels = readValue<uint32_t>(data + 16);
+        const auto sample_rate = readValue<double>(data + 24);
+        if (header_bytes > size || format > static_cast<uint32_t>(SampleFormat::Int64) || channels == 0) {
+            return fail("Corrupt recording header: " + path.string());
+        }
+
+        if (files_.empty()) {
+            std::size_t offset = kFixedHeaderBytes;
+            auto readString = [&]() {
+                const auto length = offset + 4 <= header_bytes ? readValue<uint32_t>(data + offset) : 0;
+                const std::size_t begin = std::min<std::size_t>(offset + 4, header_bytes);
+                const std::size_t end = std::min<std::size_t>(begin + length, header_bytes);
+                offset = end;
+                return std::string(reinterpret_cast<const char*>(data + begin), end - begin);
+            };
+            info_.name = readString();
+            info_.source_id = readString();
+            info_.format = static_cast<SampleFormat>(format);
+            info_.channel_count = static_cast<int>(channels);
+            info_.sample_rate = sample_rate;
+        } else if (static_cast<SampleFormat>(format) != info_.format ||
+                   static_cast<int>(channels) != info_.channel_count) {
+            return fail("Segment does not match the first one: " + path.string());
+        }
+
+        std::size_t value_bytes = 0;  // 0 for strings
+        visitSampleFormat(info_.format, [&]<typename T>() {
+            if constexpr (!std::is_same_v<T, std::string>) {
+                value_bytes = sizeof(T);
+            }
+        });
+
+        // Records up to the end marker; a record cut short by a crash ends the segment too
+        std::size_t offset = header_bytes;
+        while (offset + kRecordHeaderBytes <= size) {
+            const auto samples = readValue<uint32_t>(data + offset);
+            const auto payload = readValue<uint32_t>(data + offset + 4);
+            if (samples == 0 || offset + kRecordHeaderBytes + payload > size) {
+                break;
+            }
+            const std::byte* values = data + offset + kRecordHeaderBytes;
+            const std::size_t elements = static_cast<std::size_t>(samples) * channels;
+
+            if (value_bytes == 0) {
+                std::size_t at = 0;
+                for (std::size_t i = 0; i < elements; ++i) {
+                    const auto length = at + 4 <= payload ? readValue<uint32_t>(values + at) : 0;
+                    if (at + 4 + length > payload) {
+                        return fail("Corrupt string record in " + path.string());
+                    }
+                    strings_.emplace_back(reinterpret_cast<const char*>(values + at + 4), length);
+                    at += 4 + length;
+                }
+                values = nullptr;
+            } else if (payload != elements * value_bytes) {
+                return fail("Corrupt record in " + path.string());
+            }
+
+            blocks_.push_back({
+                .first = sample,
+                .samples = samples,
+                .timestamp = readValue<double>(data + offset + 8),
+                .sample_interval = readValue<double>(data + offset + 16),
+                .data = values
+            });
+            sample += samples;
+            offset += kRecordHeaderBytes + payload;
+        }
+        files_.push_back(std::move(file));
+    }
+    return true;
+}
+
+bool FileReplayDevice::loadCsv() {
+    auto file = std::make_unique<MappedFile>();
+    if (!file->openReadOnly(config_.path)) {
+        return fail(file->error());
+    }
+    std::string_view text(reinterpret_cast<const char*>(file->data()), file->size());
+    const bool strings = config_.format == SampleFormat::String;
+
+    std::size_t channels = 0;
+    std::size_t line_number = 0;
+    std::vector<std::string_view> fields;
+    while (!text.empty()) {
+        const std::size_t end = text.find('\n');
+        const std::string_view line = trim(text.substr(0, end));
+        text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+        ++line_number;
+        if (line.empty() || line.front() == '#') {
+            continue;
+        }
+
+        fields.clear();
+        for (std::size_t begin = 0;;) {
+            const std::size_t comma = line.find(',', begin);
+            fields.push_back(line.substr(begin, comma - begin));
+            if (comma == std::string_view::npos) {
+                break;
+            }
+            begin = comma + 1;
+        }
+
+        const auto timestamp = parseFiniteNumber(fields.front());
+        if (!timestamp) {
+            if (blocks_.empty()) {
+                continue;  // Column headings
+            }
+            return fail(config_.path.string() + ":" + std::to_string(line_number) + ": bad timestamp");
+        }
+        if (channels == 0) {
+            channels = fields.size() - 1;
+            if (channels == 0) {
+                return fail(config_.path.string() + ": no channel columns");
+            }
+        }
+        if (fields.size() - 1 != channels) {
+            return fail(config_.path.string() + ":" + std::to_string(line_number) + ": expected " +
+                        std::to_string(channels) + " values");
+        }
+
+        for (std::size_t i = 1; i < fields.size(); ++i) {
+            if (strings) {
+                strings_.emplace_back(trim(fields[i]));
+            } else {
+                const auto value = parseNumber(fields[i]);  // NaN marks a missing value
+                if (!value) {
+                    return fail(config_.path.string() + ":" + std::to_string(line_number) + ": bad value");
+                }
+                csv_values_.push_back(*value);
+            }
+        }
+        blocks_.push_back({.first = blocks_.size(), .samples = 1, .timestamp = *timestamp});
+    }
+
+    info_.name = config_.name;
+    info_.source_id = config_.name + "_replay";
+    info_.format = config_.format;
+    info_.channel_count = static_cast<int>(channels);
+    info_.sample_rate = config_.sample_rate;
+    if (info_.sample_rate <= 0 && blocks_.size() > 1) {
+        const double span = blocks_.back().timestamp - blocks_.front().timestamp;
+        info_.sample_rate = span > 0 ? static_cast<double>(blocks_.size() - 1) / span : 0.0;
+    }
+    return true;
+}
+
+void FileReplayDevice::finishIndex() {
+    if (blocks_.empty()) {
+        fail("No samples in " + config_.path.string());
+        return;
+    }
+    total_samples_ = blocks_.back().first + blocks_.back().samples;
+
+    // One pass lasts from the first chunk to one average chunk spacing past the last
+    const double span = blocks_.back().timestamp - blocks_.front().timestamp;
+    double spacing = blocks_.size() > 1 ? span / static_cast<double>(blocks_.size() - 1) : 0.0;
+    if (spacing <= 0.0) {
+        spacing = info_.sample_rate > 0
+            ? static_cast<double>(blocks_.back().samples) / info_.sample_rate
+            : 1.0;
+    }
+    period_ = span + spacing;
+
+    info_.type = config_.type;
+    if (config_.speed > 0) {
+        info_.sample_rate *= config_.speed;
+        info_.timestamp_clock = TimestampClock::Device;
+    }
+}
+
+bool FileReplayDevice::connect() {
+    if (!isValid()) {
+        return false;
+    }
+    start_ = Clock::now();
+    block_ = 0;
+    offset_ = 0;
+    loop_ = 0;
+    connected_ = true;
+    return true;
+}
+
+void FileReplayDevice::disconnect() {
+    connected_ = false;
+}
+
+bool FileReplayDevice::isConnected() const {
+    return connected_;
+}
+
+DeviceInfo FileReplayDevice::getInfo() const {
+    return info_;
+}
+
+std::size_t FileReplayDevice::getData(std::span<float> out, double& timestamp) { return replay(out, timestamp); }
+std::size_t FileReplayDevice::getData(std::span<double> out, double& timestamp) { return replay(out, timestamp); }
+std::size_t FileReplayDevice::getData(std::span<int64_t> out, double& timestamp) { return replay(out, timestamp); }
+std::size_t FileReplayDevice::getData(std::span<int32_t> out, double& timestamp) { return replay(out, timestamp); }
+std::size_t FileReplayDevice::getData(std::span<int16_t> out, double& timestamp) { return replay(out, timestamp); }
+std::size_t FileReplayDevice::getData(std::span<int8_t> out, double& timestamp) { return replay(out, timestamp); }
+std::size_t FileReplayDevice::getData(std::span<std::string> out, double& timestamp) { return replay(out, timestamp); }
+
+FileReplayDevice::Clock::time_point FileReplayDevice::due(std::size_t block, uint64_t loop) const {
+    const double recorded = blocks_[block].timestamp - blocks_.front().timestamp +
+        static_cast<double>(loop) * period_;
+    return start_ + std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(recorded / config_.speed));
+}
+
+template <typename T>
+std::size_t FileReplayDevice::replay(std::span<T> out, double& timestamp) {
+    if (!connected_ || sampleFormatOf<T>() != info_.format) {
+        return kReadError;
+    }
+    if (block_ >= blocks_.size()) {
+        return kEndOfData;  // A recording that does not loop has ended
+    }
+
+    const std::size_t channels = static_cast<std::size_t>(info_.channel_count);
+    const std::size_t capacity = out.size() / channels;
+    const bool timed = config_.speed > 0;
+    if (timed && config_.blocking) {
+        sleepUntil(std::min(due(block_, loop_), Clock::now() + kMaxWait), stopToken());
+    }
+
+    // Everything due by now that fits, possibly spanning several chunks
+    const auto now = Clock::now();
+    std::size_t written = 0;
+    double recorded = 0.0;  // Recorded time of the last sample written, from the start
+    while (written < capacity && block_ < blocks_.size()) {
+        if (timed && due(block_, loop_) > now) {
+            break;
+        }
+        const Block& block = blocks_[block_];
+        const std::size_t n = std::min(block.samples - offset_, capacity - written);
+        copySamples(block, offset_, n, out.data() + written * channels);
+        written += n;
+        offset_ += n;
+        recorded = block.timestamp - blocks_.front().timestamp + static_cast<double>(loop_) * period_ -
+            static_cast<double>(block.samples - offset_) * block.sample_interval;
+
+        if (offset_ == block.samples) {
+            offset_ = 0;
+            if (++block_ == blocks_.size() && config_.loop) {
+                block_ = 0;
+                ++loop_;
+            }
+        }
+    }
+
+    if (timed && written > 0) {
+        timestamp = kReplayEpoch + recorded / config_.speed;
+    }
+    return written;
+}
+
+template <typename T>
+void FileReplayDevice::copySamples(const Block& block, std::size_t offset, std::size_t samples, T* out) const {
+    const std::size_t channels = static_cast<std::size_t>(info_.channel_count);
+    const std::size_t elements = samples * channels;
+    const std::size_t first = (block.first + offset) * channels;
+
+    if constexpr (std::is_same_v<T, std::string>) {
+        std::copy_n(strings_.begin() + static_cast<std::ptrdiff_t>(first), elements, out);
+    } else if (block.data) {
+        // Recorded values are the stream's native type already
+        std::memcpy(out, block.data + offset * channels * sizeof(T), elements * sizeof(T));
+    } else {
+        for (std::size_t i = 0; i < elements; ++i) {
+            const double value = csv_values_[first + i];
+            if constexpr (std::is_floating_point_v<T>) {
+                out[i] = static_cast<T>(value);
+            } else {
+                out[i] = static_cast<T>(std::llround(value));
+            }
+        }
+    }
+}
+
+} // namespace lsltemplate
@@ -0,0 +1,19 @@
+#include "FilterKernelsImpl.hpp"
+
+namespace lsltemplate::simd {
+
+const FilterKernels& scalarFilterKernels() {
+    static constexpr FilterKernels kernels = makeFilterKernels<ScalarOps>("scalar");
+    return kernels;
+}
+
+const FilterKernels* neonFilterKernels() {
+#if defined(LSLTEMPLATE_SIMD_NEON)
+    static constexpr FilterKernels kernels = makeFilterKernels<NeonOps>("neon");
+    return &kernels;
+#else
+    return nullptr;
+#endif
+}
+
+} // namespace lsltemplate::simd
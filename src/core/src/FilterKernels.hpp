@@ -0,0 +1,41 @@
+#pragma once
+/**
+ * @file FilterKernels.hpp
+ * @brief Per-instruction-set biquad kernels behind FilterChain (private)
+ *
+ * Filters a channel-interleaved float buffer in place: `data` points at
+ * channel 0, consecutive samples are `channels` floats apart. Every channel
+ * runs the same cascade of biquads (transposed direct form II) with its own
+ * state; z1/z2 hold stage * channels + channel and are updated in place.
+ */
+
+#include <cstddef>
+
+namespace lsltemplate::simd {
+
+/// Most stages a kernel cascades in one pass (their state stays in registers)
+constexpr std::size_t kMaxBiquadStages = 16;
+
+/// Normalized coefficients (a0 = 1)
+struct BiquadCoefficients {
+    float b0, b1, b2, a1, a2;
+};
+
+struct FilterKernels {
+    const char* name;
+    void (*biquad)(float* data, std::size_t samples, std::size_t channels,
+                   const BiquadCoefficients* stages, std::size_t stage_count,
+                   float* z1, float* z2);
+};
+
+/// Portable reference kernels
+const FilterKernels& scalarFilterKernels();
+
+/// AVX2/FMA kernels, or nullptr if not built for this target. Only call
+/// after checking the CPU supports AVX2 and FMA.
+const FilterKernels* avx2FilterKernels();
+
+/// NEON kernels, or nullptr if not built for this target
+const FilterKernels* neonFilterKernels();
+
+} // namespace lsltemplate::simd
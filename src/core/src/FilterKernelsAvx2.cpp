@@ -0,0 +1,53 @@
+/**
+ * @file FilterKernelsAvx2.cpp
+ * @brief AVX2/FMA instantiation of the biquad kernels
+ *
+ * Compiled for AVX2 via target pragmas, as SignalKernelsAvx2.cpp.
+ */
+
+#include "FilterKernels.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2,fma"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+#endif
+
+#define LSLTEMPLATE_SIMD_AVX2 1
+#include "FilterKernelsImpl.hpp"
+
+namespace lsltemplate::simd {
+
+const FilterKernels* avx2FilterKernels() {
+    static constexpr FilterKernels kernels = makeFilterKernels<Avx2Ops>("avx2");
+    return &kernels;
+}
+
+} // namespace lsltemplate::simd
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#else
+
+namespace lsltemplate::simd {
+
+const FilterKernels* avx2FilterKernels() {
+    return nullptr;
+}
+
+} // namespace lsltemplate::simd
+
+#endif
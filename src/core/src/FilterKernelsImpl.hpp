@@ -0,0 +1,74 @@
+#pragma once
+/**
+ * @file FilterKernelsImpl.hpp
+ * @brief Biquad kernel body, instantiated once per instruction set (private)
+ *
+ * Include after SimdOps.hpp. Channels are filtered Ops::kWidth at a time
+ * through every stage of the cascade per sample, with the stage states
+ * held in locals for the whole chunk; leftover channels fall back to
+ * ScalarOps.
+ */
+
+#include "FilterKernels.hpp"
+#include "SimdOps.hpp"
+
+namespace lsltemplate::simd {
+namespace {
+
+template <class Ops>
+void biquadLanes(float* data, std::size_t samples, std::size_t channels,
+                 const BiquadCoefficients* stages, std::size_t stage_count,
+                 float* z1, float* z2, std::size_t c) {
+    using F = typename Ops::F;
+    F b0[kMaxBiquadStages], b1[kMaxBiquadStages], b2[kMaxBiquadStages];
+    F a1[kMaxBiquadStages], a2[kMaxBiquadStages];
+    F s1[kMaxBiquadStages], s2[kMaxBiquadStages];
+    for (std::size_t k = 0; k < stage_count; ++k) {
+        b0[k] = Ops::set1(stages[k].b0);
+        b1[k] = Ops::set1(stages[k].b1);
+        b2[k] = Ops::set1(stages[k].b2);
+        a1[k] = Ops::set1(stages[k].a1);
+        a2[k] = Ops::set1(stages[k].a2);
+        s1[k] = Ops::load(z1 + k * channels + c);
+        s2[k] = Ops::load(z2 + k * channels + c);
+    }
+
+    for (std::size_t s = 0; s < samples; ++s) {
+        float* p = data + s * channels + c;
+        F x = Ops::load(p);
+        for (std::size_t k = 0; k < stage_count; ++k) {
+            // y = b0 x + s1; s1' = b1 x - a1 y + s2; s2' = b2 x - a2 y
+            const F y = Ops::fmadd(b0[k], x, s1[k]);
+            s1[k] = Ops::fnmadd(a1[k], y, Ops::fmadd(b1[k], x, s2[k]));
+            s2[k] = Ops::fnmadd(a2[k], y, Ops::mul(b2[k], x));
+            x = y;
+        }
+        Ops::store(p, x);
+    }
+
+    for (std::size_t k = 0; k < stage_count; ++k) {
+        Ops::store(z1 + k * channels + c, s1[k]);
+        Ops::store(z2 + k * channels + c, s2[k]);
+    }
+}
+
+template <class Ops>
+void biquad(float* data, std::size_t samples, std::size_t channels,
+            const BiquadCoefficients* stages, std::size_t stage_count,
+            float* z1, float* z2) {
+    std::size_t c = 0;
+    for (; c + Ops::kWidth <= channels; c += Ops::kWidth) {
+        biquadLanes<Ops>(data, samples, channels, stages, stage_count, z1, z2, c);
+    }
+    for (; c < channels; ++c) {
+        biquadLanes<ScalarOps>(data, samples, channels, stages, stage_count, z1, z2, c);
+    }
+}
+
+template <class Ops>
+constexpr FilterKernels makeFilterKernels(const char* name) {
+    return {name, &biquad<Ops>};
+}
+
+} // anonymous namespace
+} // namespace lsltemplate::simd
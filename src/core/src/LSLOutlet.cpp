@@ -1,54 +1,219 @@
 #include "lsltemplate/LSLOutlet.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <string_view>
+#include <version>
 
 namespace lsltemplate {
 
-LSLOutlet::LSLOutlet(const DeviceInfo& info)
-    : info_(info)
-{
-    // Determine channel format (using float32 for this template)
-    lsl::channel_format_t format = lsl::cf_float32;
+namespace {
+
+/// liblsl channel format for a sample format
+lsl::channel_format_t toLslFormat(SampleFormat format) {
+    switch (format) {
+        case SampleFormat::Double64: return lsl::cf_double64;
+        case SampleFormat::String: return lsl::cf_string;
+        case SampleFormat::Int32: return lsl::cf_int32;
+        case SampleFormat::Int16: return lsl::cf_int16;
+        case SampleFormat::Int8: return lsl::cf_int8;
+        case SampleFormat::Int64: return lsl::cf_int64;
+        case SampleFormat::Float32: break;
+    }
+    return lsl::cf_float32;
+}
+
+/// liblsl's name of a channel format, as used in stream info XML
+const char* lslFormatName(SampleFormat format) {
+    switch (format) {
+        case SampleFormat::Double64: return "double64";
+        case SampleFormat::String: return "string";
+        case SampleFormat::Int32: return "int32";
+        case SampleFormat::Int16: return "int16";
+        case SampleFormat::Int8: return "int8";
+        case SampleFormat::Int64: return "int64";
+        case SampleFormat::Float32: break;
+    }
+    return "float32";
+}
+
+// Layouts from this size are described through one XML document
+constexpr int kBulkDescriptionChannels = 256;
+
+constexpr const char* kManufacturer = "LSL Template";
+constexpr const char* kDefaultUnit = "arbitrary";
+
+const std::string& orDefault(const std::string& value, const std::string& fallback) {
+    return value.empty() ? fallback : value;
+}
+
+void appendEscaped(std::string& out, std::string_view text) {
+    if (text.find_first_of("&<>\"") == std::string_view::npos) {
+        out += text;
+        return;
+    }
+    for (char c : text) {
+        switch (c) {
+            case '&': out += "&amp;"; break;
+            case '<': out += "&lt;"; break;
+            case '>': out += "&gt;"; break;
+            case '"': out += "&quot;"; break;
+            default: out += c; break;
+        }
+    }
+}
+
+void appendElement(std::string& out, const char* name, std::string_view text) {
+    out += '<';
+    out += name;
+    out += '>';
+    appendEscaped(out, text);
+    out += "</";
+    out += name;
+    out += '>';
+}
+
+// Shortest text that reads back as the same value; printf is an order of
+// magnitude slower and dominates large layouts with locations
+void appendNumber(std::string& out, double value) {
+    char buffer[32];
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+#else
+    const int length = std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+    out.append(buffer, static_cast<std::size_t>(std::max(0, length)));
+#endif
+}
+
+std::string formatLocation(double value) {
+    std::string text;
+    appendNumber(text, value);
+    return text;
+}
+
+/// Stream info XML with the per-channel metadata, serialized in one pass
+std::string describeXml(const DeviceInfo& info) {
+    static const std::string unit = kDefaultUnit;
+    std::string xml;
+    xml.reserve(512 + static_cast<std::size_t>(info.channel_count) *
+                (96 + info.type.size()));
+
+    xml += "<?xml version=\"1.0\"?><info>";
+    appendElement(xml, "name", info.name);
+    appendElement(xml, "type", info.type);
+    appendElement(xml, "channel_count", std::to_string(info.channel_count));
+    appendElement(xml, "channel_format", lslFormatName(info.format));
+    appendElement(xml, "source_id", info.source_id);
+    xml += "<nominal_srate>";
+    appendNumber(xml, info.sample_rate);
+    xml += "</nominal_srate>";
+    // Filled in by the outlet
+    xml += "<version>1.1</version><created_at>0</created_at><uid></uid>"
+           "<session_id>default</session_id><hostname></hostname>"
+           "<v4address></v4address><v4data_port>0</v4data_port><v4service_port>0</v4service_port>"
+           "<v6address></v6address><v6data_port>0</v6data_port><v6service_port>0</v6service_port>";
 
-    // Create stream info
+    xml += "<desc>";
+    appendElement(xml, "manufacturer", kManufacturer);
+    xml += "<channels>";
+    for (int i = 0; i < info.channel_count; ++i) {
+        const auto index = static_cast<std::size_t>(i);
+        const ChannelDescription* channel =
+            index < info.channel_layout.size() ? &info.channel_layout[index] : nullptr;
+        xml += "<channel>";
+        if (channel && !channel->label.empty()) {
+            appendElement(xml, "label", channel->label);
+        } else {
+            xml += "<label>Ch";
+            xml += std::to_string(i + 1);
+            xml += "</label>";
+        }
+        appendElement(xml, "unit", channel ? orDefault(channel->unit, unit) : unit);
+        appendElement(xml, "type", channel ? orDefault(channel->type, info.type) : info.type);
+        if (channel && channel->location) {
+            xml += "<location>";
+            const char* axes[] = {"X", "Y", "Z"};
+            for (std::size_t axis = 0; axis < 3; ++axis) {
+                xml += '<';
+                xml += axes[axis];
+                xml += '>';
+                appendNumber(xml, (*channel->location)[axis]);
+                xml += "</";
+                xml += axes[axis];
+                xml += '>';
+            }
+            xml += "</location>";
+        }
+        xml += "</channel>";
+    }
+    xml += "</channels></desc></info>";
+    return xml;
+}
+
+/// Stream info built through the element API, a few calls per channel
+lsl::stream_info describeElements(const DeviceInfo& info) {
+    static const std::string unit = kDefaultUnit;
     lsl::stream_info stream_info(
         info.name,
         info.type,
         info.channel_count,
         info.sample_rate,
-        format,
+        toLslFormat(info.format),
         info.source_id
     );
 
     // Add metadata (customize for your application)
     lsl::xml_element desc = stream_info.desc();
-    desc.append_child_value("manufacturer", "LSL Template");
+    desc.append_child_value("manufacturer", kManufacturer);
 
     // Add channel descriptions
     lsl::xml_element channels = desc.append_child("channels");
     for (int i = 0; i < info.channel_count; ++i) {
+        const auto index = static_cast<std::size_t>(i);
+        const ChannelDescription* channel =
+            index < info.channel_layout.size() ? &info.channel_layout[index] : nullptr;
         lsl::xml_element ch = channels.append_child("channel");
-        ch.append_child_value("label", "Ch" + std::to_string(i + 1));
-        ch.append_child_value("unit", "arbitrary");
-        ch.append_child_value("type", info.type);
+        ch.append_child_value("label", channel && !channel->label.empty()
+            ? channel->label
+            : "Ch" + std::to_string(i + 1));
+        ch.append_child_value("unit", channel ? orDefault(channel->unit, unit) : unit);
+        ch.append_child_value("type", channel ? orDefault(channel->type, info.type) : info.type);
+        if (channel && channel->location) {
+            lsl::xml_element location = ch.append_child("location");
+            location.append_child_value("X", formatLocation((*channel->location)[0]));
+            location.append_child_value("Y", formatLocation((*channel->location)[1]));
+            location.append_child_value("Z", formatLocation((*channel->location)[2]));
+        }
     }
-
-    // Create the outlet
-    outlet_ = std::make_unique<lsl::stream_outlet>(stream_info);
+    return stream_info;
 }
 
-LSLOutlet::~LSLOutlet() = default;
+} // anonymous namespace
 
-void LSLOutlet::pushChunk(const std::vector<float>& data) {
-    if (outlet_ && !data.empty()) {
-        outlet_->push_chunk_multiplexed(data);
+lsl::stream_info makeStreamInfo(const DeviceInfo& info, std::optional<bool> bulk) {
+    if (!bulk.value_or(info.channel_count >= kBulkDescriptionChannels)) {
+        return describeElements(info);
+    }
+    try {
+        lsl::stream_info stream_info = lsl::stream_info::from_xml(describeXml(info));
+        if (stream_info.channel_count() == info.channel_count && stream_info.name() == info.name) {
+            return stream_info;
+        }
+    } catch (const std::exception&) {
+        // Rejected by this liblsl version; build it element by element
     }
+    return describeElements(info);
 }
 
-void LSLOutlet::pushSample(const std::vector<float>& sample) {
-    if (outlet_ && !sample.empty()) {
-        outlet_->push_sample(sample);
-    }
+LSLOutlet::LSLOutlet(const DeviceInfo& info, int chunk_size, int max_buffered)
+    : info_(info)
+{
+    outlet_ = std::make_unique<lsl::stream_outlet>(makeStreamInfo(info), chunk_size, max_buffered);
 }
 
+LSLOutlet::~LSLOutlet() = default;
+
 std::string LSLOutlet::getStreamName() const {
     return info_.name;
 }
@@ -57,4 +222,8 @@ bool LSLOutlet::hasConsumers() const {
     return outlet_ && outlet_->have_consumers();
 }
 
+SampleFormat LSLOutlet::getFormat() const {
+    return info_.format;
+}
+
 } // namespace lsltemplate
@@ -0,0 +1,256 @@
+#include "MappedFile.hpp"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace lsltemplate {
+
+namespace {
+
+#ifdef _WIN32
+std::string lastError() {
+    return "error " + std::to_string(GetLastError());
+}
+
+std::size_t pageSize() {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwAllocationGranularity;
+}
+#else
+std::string lastError() {
+    return std::strerror(errno);
+}
+
+std::size_t pageSize() {
+    return static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+}
+#endif
+
+} // anonymous namespace
+
+MappedFile::~MappedFile() {
+    if (isOpen()) {
+        close(size_);
+    }
+}
+
+bool MappedFile::fail(const std::string& what) {
+    error_ = what + " " + path_.string() + ": " + lastError();
+    release();
+    return false;
+}
+
+bool MappedFile::open(const std::filesystem::path& path, std::size_t size) {
+    if (isOpen()) {
+        close(size_);
+    }
+    path_ = path;
+    size_ = size;
+    read_only_ = false;
+
+    // Failures after creating the file leave nothing behind
+    auto abandon = [&](const std::string& what) {
+        fail(what);
+        std::error_code ignored;
+        std::filesystem::remove(path, ignored);
+        return false;
+    };
+
+#ifdef _WIN32
+    file_ = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ,
+                        nullptr, CREATE_NEW, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file_ == INVALID_HANDLE_VALUE) {
+        file_ = nullptr;
+        return fail("Cannot create");
+    }
+    LARGE_INTEGER length;
+    length.QuadPart = static_cast<LONGLONG>(size);
+    if (!SetFilePointerEx(file_, length, nullptr, FILE_BEGIN) || !SetEndOfFile(file_)) {
+        return abandon("Cannot allocate");
+    }
+    mapping_ = CreateFileMappingW(file_, nullptr, PAGE_READWRITE, 0, 0, nullptr);
+    if (!mapping_) {
+        return abandon("Cannot map");
+    }
+    data_ = static_cast<std::byte*>(MapViewOfFile(mapping_, FILE_MAP_WRITE, 0, 0, size));
+    if (!data_) {
+        return abandon("Cannot map");
+    }
+#else
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        return fail("Cannot create");
+    }
+    if (ftruncate(fd_, static_cast<off_t>(size)) != 0) {
+        return abandon("Cannot allocate");
+    }
+#ifdef __linux__
+    // Reserve the blocks now; EOPNOTSUPP means the filesystem cannot, and
+    // the sparse file from ftruncate() has to do
+    const int reserved = posix_fallocate(fd_, 0, static_cast<off_t>(size));
+    if (reserved != 0 && reserved != EOPNOTSUPP && reserved != EINVAL) {
+        errno = reserved;
+        return abandon("Cannot allocate");
+    }
+#endif
+    void* mapped = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (mapped == MAP_FAILED) {
+        return abandon("Cannot map");
+    }
+    munlock(mapped, size);  // Not pinned by lockMemory(): the writer only streams through it
+    data_ = static_cast<std::byte*>(mapped);
+#endif
+    return true;
+}
+
+bool MappedFile::openReadOnly(const std::filesystem::path& path) {
+    if (isOpen()) {
+        close(size_);
+    }
+    path_ = path;
+    read_only_ = true;
+
+#ifdef _WIN32
+    file_ = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                        nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file_ == INVALID_HANDLE_VALUE) {
+        file_ = nullptr;
+        return fail("Cannot open");
+    }
+    LARGE_INTEGER length;
+    if (!GetFileSizeEx(file_, &length)) {
+        return fail("Cannot read size of");
+    }
+    size_ = static_cast<std::size_t>(length.QuadPart);
+    if (size_ == 0) {
+        error_ = "Empty file " + path.string();
+        release();
+        return false;
+    }
+    mapping_ = CreateFileMappingW(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping_) {
+        return fail("Cannot map");
+    }
+    data_ = static_cast<std::byte*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, size_));
+    if (!data_) {
+        return fail("Cannot map");
+    }
+#else
+    fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd_ < 0) {
+        return fail("Cannot open");
+    }
+    struct stat status {};
+    if (fstat(fd_, &status) != 0) {
+        return fail("Cannot read size of");
+    }
+    size_ = static_cast<std::size_t>(status.st_size);
+    if (size_ == 0) {
+        error_ = "Empty file " + path.string();
+        release();
+        return false;
+    }
+    void* mapped = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd_, 0);
+    if (mapped == MAP_FAILED) {
+        return fail("Cannot map");
+    }
+    munlock(mapped, size_);  // Likewise, a whole recording would not fit in locked memory
+    data_ = static_cast<std::byte*>(mapped);
+    madvise(mapped, size_, MADV_SEQUENTIAL);
+#endif
+    return true;
+}
+
+bool MappedFile::sync(std::size_t offset, std::size_t length) {
+    if (!isOpen() || length == 0) {
+        return true;
+    }
+    const std::size_t begin = offset - offset % pageSize();
+    length += offset - begin;
+
+#ifdef _WIN32
+    if (!FlushViewOfFile(data_ + begin, length) || !FlushFileBuffers(file_)) {
+        error_ = "Cannot sync " + path_.string() + ": " + lastError();
+        return false;
+    }
+#else
+    if (msync(data_ + begin, length, MS_SYNC) != 0) {
+        error_ = "Cannot sync " + path_.string() + ": " + lastError();
+        return false;
+    }
+#endif
+    return true;
+}
+
+bool MappedFile::close(std::size_t used) {
+    if (!isOpen()) {
+        return true;
+    }
+    if (read_only_) {
+        release();
+        return true;
+    }
+    bool ok = sync(0, used);
+
+#ifdef _WIN32
+    UnmapViewOfFile(data_);
+    data_ = nullptr;
+    CloseHandle(mapping_);
+    mapping_ = nullptr;
+    LARGE_INTEGER length;
+    length.QuadPart = static_cast<LONGLONG>(used);
+    if (!SetFilePointerEx(file_, length, nullptr, FILE_BEGIN) || !SetEndOfFile(file_)) {
+        error_ = "Cannot truncate " + path_.string() + ": " + lastError();
+        ok = false;
+    }
+#else
+    munmap(data_, size_);
+    data_ = nullptr;
+    if (ftruncate(fd_, static_cast<off_t>(used)) != 0 || fsync(fd_) != 0) {
+        error_ = "Cannot truncate " + path_.string() + ": " + lastError();
+        ok = false;
+    }
+#endif
+    release();
+    return ok;
+}
+
+void MappedFile::release() {
+#ifdef _WIN32
+    if (data_) {
+        UnmapViewOfFile(data_);
+    }
+    if (mapping_) {
+        CloseHandle(mapping_);
+    }
+    if (file_) {
+        CloseHandle(file_);
+    }
+    mapping_ = nullptr;
+    file_ = nullptr;
+#else
+    if (data_) {
+        munmap(data_, size_);
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+    fd_ = -1;
+#endif
+    data_ = nullptr;
+    size_ = 0;
+}
+
+} // namespace lsltemplate
@@ -0,0 +1,75 @@
+#pragma once
+/**
+ * @file MappedFile.hpp
+ * @brief Memory-mapped files: preallocated output, or read-only input (private)
+ */
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+
+namespace lsltemplate {
+
+/**
+ * @brief Mapping of a newly created file of fixed size, or of an existing
+ *        file for reading
+ *
+ * For output the file's blocks are reserved up front where the filesystem
+ * supports it, so running out of disk space fails open() instead of
+ * faulting a later store into the mapping. Closed (keeping everything) on
+ * destruction.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Create path (which must not exist) with the given size and map it
+     * @return false on failure; see error()
+     */
+    bool open(const std::filesystem::path& path, std::size_t size);
+
+    /**
+     * @brief Map an existing file read-only
+     * @return false on failure; see error()
+     */
+    bool openReadOnly(const std::filesystem::path& path);
+
+    /**
+     * @brief Write back dirty pages overlapping [offset, offset + length)
+     *        and wait for them to reach the disk
+     */
+    bool sync(std::size_t offset, std::size_t length);
+
+    /// Unmap and cut the file down to its first `used` bytes (output only)
+    bool close(std::size_t used);
+
+    bool isOpen() const { return data_ != nullptr; }
+    std::byte* data() const { return data_; }
+    std::size_t size() const { return size_; }
+
+    /// Description of the last failure
+    const std::string& error() const { return error_; }
+
+private:
+    bool fail(const std::string& what);
+    void release();
+
+    std::byte* data_ = nullptr;
+    std::size_t size_ = 0;
+    std::filesystem::path path_;
+    std::string error_;
+    bool read_only_ = false;
+#ifdef _WIN32
+    void* file_ = nullptr;     // HANDLE
+    void* mapping_ = nullptr;  // HANDLE
+#else
+    int fd_ = -1;
+#endif
+};
+
+} // namespace lsltemplate
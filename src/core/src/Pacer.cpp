@@ -0,0 +1,93 @@
+#include "lsltemplate/Pacer.hpp"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace lsltemplate {
+
+bool sleepUntil(std::chrono::steady_clock::time_point deadline, const std::stop_token& stop) {
+    if (!stop.stop_possible()) {
+        std::this_thread::sleep_until(deadline);
+        return true;
+    }
+    // Per thread, so waiting never allocates (condition_variable_any may)
+    thread_local std::mutex mutex;
+    thread_local std::condition_variable_any wakeup;
+    std::unique_lock<std::mutex> lock(mutex);
+    wakeup.wait_until(lock, stop, deadline, [] { return false; });
+    return !stop.stop_requested();
+}
+
+Pacer::Pacer(const Config& config)
+    : config_(config)
+{
+    reset();
+}
+
+void Pacer::reset() {
+    start_ = Clock::now();
+    reset_time_ = start_;
+    last_release_ = start_;
+    samples_ = 0;
+    base_samples_ = 0;
+    resyncs_ = 0;
+}
+
+void Pacer::wait(uint64_t samples, const std::stop_token& stop) {
+    samples_ += samples;
+    if (config_.rate <= 0.0) {
+        last_release_ = Clock::now();
+        return;
+    }
+
+    const auto due = deadline();
+    const auto now = Clock::now();
+
+    if (now - due > config_.max_lag) {
+        // Hopelessly late: re-anchor so the next chunk is due one period out
+        start_ = now;
+        base_samples_ = samples_;
+        ++resyncs_;
+        last_release_ = now;
+        return;
+    }
+
+    if (config_.spin.count() > 0) {
+        if (sleepUntil(due - config_.spin, stop)) {
+            while (Clock::now() < due && !stop.stop_requested()) {
+                std::this_thread::yield();
+            }
+        }
+    } else {
+        sleepUntil(due, stop);
+    }
+    last_release_ = Clock::now();
+}
+
+void Pacer::advance(uint64_t samples) {
+    samples_ += samples;
+    last_release_ = Clock::now();
+}
+
+uint64_t Pacer::available() const {
+    if (config_.rate <= 0.0) {
+        return 0;
+    }
+    const double elapsed = std::chrono::duration<double>(Clock::now() - start_).count();
+    const auto due = base_samples_ + static_cast<uint64_t>(elapsed * config_.rate);
+    return due > samples_ ? due - samples_ : 0;
+}
+
+double Pacer::achievedRate() const {
+    const double elapsed = std::chrono::duration<double>(last_release_ - reset_time_).count();
+    return elapsed > 0.0 ? static_cast<double>(samples_) / elapsed : 0.0;
+}
+
+Pacer::Clock::time_point Pacer::deadline() const {
+    // Computed from the total count, never accumulated, so it cannot drift
+    const std::chrono::duration<double> offset(
+        static_cast<double>(samples_ - base_samples_) / config_.rate);
+    return start_ + std::chrono::duration_cast<Clock::duration>(offset);
+}
+
+} // namespace lsltemplate
@@ -0,0 +1,81 @@
+#include "lsltemplate/PreviewBuffer.hpp"
+#include <cmath>
+#include <cstring>
+
+namespace lsltemplate {
+
+namespace {
+
+constexpr float kEmptyMin = std::numeric_limits<float>::infinity();
+constexpr float kEmptyMax = -std::numeric_limits<float>::infinity();
+
+} // anonymous namespace
+
+PreviewBuffer::PreviewBuffer(const Config& config, std::size_t channels, double sample_rate)
+    : channels_(std::max<std::size_t>(1, channels))
+    , capacity_(std::max<std::size_t>(2, config.columns))
+{
+    // Irregular streams are sized for 100 samples per second, as liblsl does
+    const double rate = sample_rate > 0 ? sample_rate : 100.0;
+    samples_per_column_ = static_cast<std::size_t>(
+        std::max(1.0, std::round(config.window * rate / static_cast<double>(capacity_))));
+    column_duration_ = static_cast<double>(samples_per_column_) / rate;
+    publish_every_ = config.refresh > 0
+        ? static_cast<uint64_t>(std::max(1.0, rate / config.refresh)) : 1;
+
+    min_.assign(channels_ * capacity_, kEmptyMin);
+    max_.assign(channels_ * capacity_, kEmptyMax);
+    for (auto& frame : frames_) {
+        frame.channels = channels_;
+        frame.capacity = capacity_;
+        frame.column_duration = column_duration_;
+        frame.min.assign(channels_ * capacity_, 0.0f);
+        frame.max.assign(channels_ * capacity_, 0.0f);
+    }
+}
+
+const PreviewFrame* PreviewBuffer::latest() {
+    if (middle_.load(std::memory_order_relaxed) & kFresh) {
+        front_ = middle_.exchange(front_, std::memory_order_acq_rel) & kIndexMask;
+        published_ = true;
+    }
+    return published_ ? &frames_[front_] : nullptr;
+}
+
+void PreviewBuffer::advance() {
+    head_ = head_ + 1 == capacity_ ? 0 : head_ + 1;
+    completed_ = std::min(completed_ + 1, capacity_);
+    column_fill_ = 0;
+    std::fill_n(min_.begin() + static_cast<std::ptrdiff_t>(head_ * channels_), channels_, kEmptyMin);
+    std::fill_n(max_.begin() + static_cast<std::ptrdiff_t>(head_ * channels_), channels_, kEmptyMax);
+}
+
+void PreviewBuffer::publish() {
+    // The reader has not taken the last frame: leave it, try again next chunk
+    if (middle_.load(std::memory_order_acquire) & kFresh) {
+        return;
+    }
+
+    // The head column counts once it holds a sample; it is cleared on entry,
+    // so the completed ones before it fill at most capacity_ - 1 columns
+    const std::size_t columns = std::min(completed_, capacity_ - 1) + (column_fill_ > 0 ? 1 : 0);
+    const std::size_t end = column_fill_ > 0 ? head_ + 1 : head_;
+    const std::size_t oldest = (end + capacity_ - columns) % capacity_;
+    const std::size_t first = std::min(columns, capacity_ - oldest);
+
+    PreviewFrame& frame = frames_[back_];
+    const std::size_t head = first * channels_;
+    const std::size_t tail = (columns - first) * channels_;
+    std::memcpy(frame.min.data(), min_.data() + oldest * channels_, head * sizeof(float));
+    std::memcpy(frame.max.data(), max_.data() + oldest * channels_, head * sizeof(float));
+    std::memcpy(frame.min.data() + head, min_.data(), tail * sizeof(float));
+    std::memcpy(frame.max.data() + head, max_.data(), tail * sizeof(float));
+    frame.columns = columns;
+    frame.samples = samples_;
+    frame.sequence = ++sequence_;
+
+    since_publish_ = 0;
+    back_ = middle_.exchange(static_cast<uint8_t>(back_ | kFresh), std::memory_order_acq_rel) & kIndexMask;
+}
+
+} // namespace lsltemplate
@@ -0,0 +1,105 @@
+#include "lsltemplate/RateMonitor.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace lsltemplate {
+
+RateMonitor::RateMonitor(const Config& config, double sample_rate, double chunk_period)
+    : config_(config)
+    , sample_rate_(sample_rate > 0 ? sample_rate : 0.0)
+    , slot_(std::chrono::duration_cast<Clock::duration>(
+          std::chrono::duration<double>(std::max(config.window, 0.01) / kSlots)))
+{
+    if (sample_rate_ == 0.0) {
+        config_.tolerance = 0.0;  // Nothing to compare against
+    }
+    setChunkPeriod(chunk_period);
+    restart(Clock::now());
+}
+
+void RateMonitor::restart(Clock::time_point now) {
+    oldest_ = 0;
+    count_ = 0;
+    next_checkpoint_ = now;
+    last_chunk_ = now;
+    samples_ = 0;
+    rate_ = 0.0;
+    deviating_ = false;
+    stalled_ = false;
+}
+
+void RateMonitor::setChunkPeriod(double chunk_period) {
+    chunk_period_ = chunk_period;
+    stall_limit_ = sample_rate_ > 0.0 && config_.stall_factor > 0.0
+        ? config_.stall_factor * chunk_period : 0.0;
+}
+
+RateMonitor::Event RateMonitor::onRead(std::size_t samples, Clock::time_point now) {
+    const double gap = std::chrono::duration<double>(now - last_chunk_).count();
+    if (samples == 0) {
+        // Report an ongoing stall as soon as it crosses the limit, once
+        if (!stalled_ && stall_limit_ > 0.0 && gap > stall_limit_) {
+            stalled_ = true;
+            last_gap_ = gap;
+            return Event::Stall;
+        }
+        return Event::None;
+    }
+
+    last_chunk_ = now;
+    samples_ += samples;
+
+    // One event per chunk: a due rate evaluation waits for the next one.
+    // The samples on both sides of the gap still count towards the rate.
+    if (stalled_) {
+        stalled_ = false;
+        last_gap_ = gap;
+        return Event::Resumed;
+    }
+    if (stall_limit_ > 0.0 && gap > stall_limit_) {
+        // The read blocked through the whole stall: it is over already
+        last_gap_ = gap;
+        return Event::Stall;
+    }
+    if (now >= next_checkpoint_) {
+        next_checkpoint_ = now + slot_;
+        return evaluate(now);
+    }
+    return Event::None;
+}
+
+RateMonitor::Event RateMonitor::evaluate(Clock::time_point now) {
+    // Ring of the last kSlots + 1 checkpoints: the oldest is a window ago
+    if (count_ == checkpoints_.size()) {
+        oldest_ = (oldest_ + 1) % checkpoints_.size();
+        --count_;
+    }
+    checkpoints_[(oldest_ + count_) % checkpoints_.size()] = {now, samples_};
+    ++count_;
+    if (count_ < checkpoints_.size()) {
+        return Event::None;
+    }
+
+    const Checkpoint& oldest = checkpoints_[oldest_];
+    const double span = std::chrono::duration<double>(now - oldest.time).count();
+    if (span <= 0.0) {
+        return Event::None;
+    }
+    rate_ = static_cast<double>(samples_ - oldest.samples) / span;
+
+    if (config_.tolerance <= 0.0) {
+        return Event::None;
+    }
+    const double deviation = std::abs(rate_ / sample_rate_ - 1.0);
+    if (!deviating_ && deviation > config_.tolerance) {
+        deviating_ = true;
+        return Event::RateDeviation;
+    }
+    if (deviating_ && deviation < config_.tolerance / 2.0) {
+        deviating_ = false;
+        return Event::RateRecovered;
+    }
+    return Event::None;
+}
+
+} // namespace lsltemplate
@@ -0,0 +1,292 @@
+#include "lsltemplate/Recorder.hpp"
+#include "MappedFile.hpp"
+#include "RecordingFormat.hpp"
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+#include <type_traits>
+
+namespace lsltemplate {
+
+namespace {
+
+using recording::kRecordHeaderBytes;
+
+void put(std::byte*& out, const void* data, std::size_t bytes) {
+    std::memcpy(out, data, bytes);
+    out += bytes;
+}
+
+template <typename V>
+void putValue(std::byte*& out, V value) {
+    put(out, &value, sizeof(value));
+}
+
+void putString(std::byte*& out, const std::string& value) {
+    putValue(out, static_cast<uint32_t>(value.size()));
+    put(out, value.data(), value.size());
+}
+
+// Serialized size of channel-interleaved values
+template <typename T>
+std::size_t payloadBytes(const T* data, std::size_t elements) {
+    if constexpr (std::is_same_v<T, std::string>) {
+        std::size_t bytes = 0;
+        for (std::size_t i = 0; i < elements; ++i) {
+            bytes += sizeof(uint32_t) + data[i].size();
+        }
+        return bytes;
+    } else {
+        return elements * sizeof(T);
+    }
+}
+
+// Local start time, shared by all segments of a recording
+std::string sessionStamp() {
+    const std::time_t now = std::time(nullptr);
+    std::tm local{};
+#ifdef _WIN32
+    localtime_s(&local, &now);
+#else
+    localtime_r(&now, &local);
+#endif
+    std::ostringstream out;
+    out << std::put_time(&local, "%Y%m%dT%H%M%S");
+    return out.str();
+}
+
+} // anonymous namespace
+
+/**
+ * @brief Segment file state, used by the writer thread only
+ */
+class Recorder::Writer {
+public:
+    Writer(const Recorder::Config& config, const DeviceInfo& info)
+        : config_(config)
+        , info_(info)
+        , session_(sessionStamp())
+    {
+    }
+
+    /// Close the current segment and start one with room for record_bytes
+    bool openSegment(std::size_t record_bytes) {
+        if (!closeSegment()) {
+            return false;
+        }
+
+        const std::size_t header = recording::kFixedHeaderBytes +
+            sizeof(uint32_t) + info_.name.size() + sizeof(uint32_t) + info_.source_id.size();
+        const auto path = segmentPath(config_.path, session_, segments_);
+        if (!file_.open(path, std::max(config_.segment_bytes, header + record_bytes))) {
+            error_ = file_.error();
+            return false;
+        }
+
+        std::byte* out = file_.data();
+        put(out, recording::kMagic, sizeof(recording::kMagic));
+        putValue(out, static_cast<uint32_t>(header));
+        putValue(out, static_cast<uint32_t>(info_.format));
+        putValue(out, static_cast<uint32_t>(info_.channel_count));
+        putValue(out, static_cast<uint32_t>(segments_));
+        putValue(out, info_.sample_rate);
+        putString(out, info_.name);
+        putString(out, info_.source_id);
+
+        ++segments_;
+        used_ = header;
+        synced_ = 0;
+        bytes_ += header;
+        last_sync_ = std::chrono::steady_clock::now();
+        return true;
+    }
+
+    /// Sync and cut the current segment to its used length
+    bool closeSegment() {
+        if (file_.isOpen() && !file_.close(used_)) {
+            error_ = file_.error();
+            return false;
+        }
+        return true;
+    }
+
+    template <typename T>
+    bool append(const Chunk<T>& chunk, std::size_t channels) {
+        const std::size_t elements = chunk.samples * channels;
+        const std::size_t payload = payloadBytes(chunk.data.data(), elements);
+        const std::size_t bytes = kRecordHeaderBytes + payload;
+        if (!file_.isOpen() || used_ + bytes > file_.size()) {
+            if (!openSegment(bytes)) {
+                return false;
+            }
+        }
+
+        std::byte* out = file_.data() + used_;
+        putValue(out, static_cast<uint32_t>(chunk.samples));
+        putValue(out, static_cast<uint32_t>(payload));
+        putValue(out, chunk.timestamp);
+        putValue(out, chunk.sample_interval);
+        if constexpr (std::is_same_v<T, std::string>) {
+            for (std::size_t i = 0; i < elements; ++i) {
+                putString(out, chunk.data[i]);
+            }
+        } else {
+            put(out, chunk.data.data(), payload);
+        }
+        used_ += bytes;
+        bytes_ += bytes;
+
+        if (std::chrono::steady_clock::now() - last_sync_ >= config_.sync_interval) {
+            return sync();
+        }
+        return true;
+    }
+
+    bool sync() {
+        if (!file_.sync(synced_, used_ - synced_)) {
+            error_ = file_.error();
+            return false;
+        }
+        synced_ = used_;
+        last_sync_ = std::chrono::steady_clock::now();
+        return true;
+    }
+
+    uint64_t bytes() const { return bytes_; }
+    uint64_t segments() const { return segments_; }
+    const std::string& error() const { return error_; }
+
+private:
+    const Recorder::Config& config_;
+    const DeviceInfo& info_;
+    const std::string session_;
+
+    MappedFile file_;
+    std::size_t used_ = 0;    // Bytes of the segment written
+    std::size_t synced_ = 0;  // Bytes of the segment known to be on disk
+    std::chrono::steady_clock::time_point last_sync_;
+    uint64_t segments_ = 0;
+    uint64_t bytes_ = 0;
+    std::string error_;
+};
+
+Recorder::Recorder(
+    const Config& config,
+    const DeviceInfo& info,
+    std::size_t max_chunk_samples,
+    StatusCallback callback
+)
+    : config_(config)
+    , info_(info)
+    , channels_(static_cast<std::size_t>(std::max(1, info.channel_count)))
+    , max_chunk_samples_(std::max<std::size_t>(1, max_chunk_samples))
+    , statusCallback_(std::move(callback))
+{
+    // Drop-newest: a writer stuck on the disk loses new chunks, never blocks
+    visitSampleFormat(info_.format, [&]<typename T>() {
+        ring_ = std::make_unique<ChunkRing<T>>(
+            config_.queue_chunks,
+            max_chunk_samples_ * channels_,
+            OverflowPolicy::DropNewest
+        );
+    });
+}
+
+Recorder::~Recorder() {
+    stop();
+}
+
+bool Recorder::start() {
+    if (thread_ || ring_->isClosed()) {
+        return false;  // Running, or already used
+    }
+
+    writer_ = std::make_unique<Writer>(config_, info_);
+    if (!writer_->openSegment(0)) {
+        report("Recording failed: " + writer_->error(), true);
+        writer_.reset();
+        return false;
+    }
+    bytes_.store(writer_->bytes(), std::memory_order_relaxed);
+    segments_.store(writer_->segments(), std::memory_order_relaxed);
+
+    thread_ = std::make_unique<std::thread>(&Recorder::writerFunction, this);
+    report("Recording " + info_.name + " to " + config_.path.string(), false);
+    return true;
+}
+
+void Recorder::stop() {
+    if (!thread_) {
+        return;
+    }
+    ring_->close();
+    thread_->join();
+    thread_.reset();
+    writer_.reset();
+}
+
+RecorderStats Recorder::stats() const {
+    const auto ring = ring_->stats();
+    return {
+        .chunks = chunks_.load(std::memory_order_relaxed),
+        .samples = samples_.load(std::memory_order_relaxed),
+        .bytes = bytes_.load(std::memory_order_relaxed),
+        .dropped = ring.dropped + lost_.load(std::memory_order_relaxed),
+        .segments = segments_.load(std::memory_order_relaxed),
+        .queue_high_water = ring.high_water,
+        .failed = failed_.load(std::memory_order_relaxed)
+    };
+}
+
+std::filesystem::path Recorder::segmentPath(
+    const std::filesystem::path& base,
+    const std::string& session,
+    std::size_t index
+) {
+    std::ostringstream name;
+    name << base.stem().string() << '_' << session << '_'
+         << std::setw(4) << std::setfill('0') << index << base.extension().string();
+    return base.parent_path() / name.str();
+}
+
+void Recorder::writerFunction() {
+    visitSampleFormat(info_.format, [&]<typename T>() {
+        drain(static_cast<ChunkRing<T>&>(*ring_), *writer_);
+    });
+
+    if (!failed_ && !writer_->closeSegment()) {
+        failed_ = true;
+        report("Recording failed: " + writer_->error(), true);
+    }
+}
+
+template <typename T>
+void Recorder::drain(ChunkRing<T>& ring, Writer& writer) {
+    while (Chunk<T>* chunk = ring.read()) {
+        if (failed_.load(std::memory_order_relaxed)) {
+            lost_.store(lost_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        } else if (writer.append(*chunk, channels_)) {
+            chunks_.store(chunks_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            samples_.store(samples_.load(std::memory_order_relaxed) + chunk->samples,
+                           std::memory_order_relaxed);
+            bytes_.store(writer.bytes(), std::memory_order_relaxed);
+            segments_.store(writer.segments(), std::memory_order_relaxed);
+        } else {
+            // Keep what was written; count the rest as dropped
+            failed_.store(true, std::memory_order_relaxed);
+            lost_.store(lost_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            writer.closeSegment();
+            report("Recording failed: " + writer.error(), true);
+        }
+        ring.release();
+    }
+}
+
+void Recorder::report(const std::string& message, bool is_error) {
+    if (statusCallback_) {
+        statusCallback_(message, is_error);
+    }
+}
+
+} // namespace lsltemplate
@@ -0,0 +1,20 @@
+#pragma once
+/**
+ * @file RecordingFormat.hpp
+ * @brief Constants of the segment file layout described in Recorder.hpp (private)
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace lsltemplate::recording {
+
+constexpr char kMagic[8] = {'L', 'S', 'L', 'T', 'R', 'E', 'C', '1'};
+
+/// magic, header_bytes, format, channels, segment, sample_rate
+constexpr std::size_t kFixedHeaderBytes = sizeof(kMagic) + 4 * sizeof(uint32_t) + sizeof(double);
+
+/// samples, payload_bytes, timestamp, sample_interval
+constexpr std::size_t kRecordHeaderBytes = 2 * sizeof(uint32_t) + 2 * sizeof(double);
+
+} // namespace lsltemplate::recording
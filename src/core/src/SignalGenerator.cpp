@@ -0,0 +1,327 @@
+#include "lsltemplate/SignalGenerator.hpp"
+#include "CpuFeatures.hpp"
+#include "SignalKernels.hpp"
+#include "TextParsing.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace lsltemplate {
+
+namespace {
+
+// Phasor magnitude is renormalised at least this often (float rounding
+// would otherwise let the amplitude creep by ~1e-7 per sample)
+constexpr std::size_t kBlockSamples = 1024;
+
+// Chirp rotation is recomputed in double precision every this many samples
+constexpr uint64_t kChirpStep = 32;
+
+// Float counters stay exact up to 2^24
+constexpr float kCounterLimit = 16777216.0f;
+
+const simd::SignalKernels* selectKernels() {
+    if (simd::simdEnabled()) {
+        if (auto* neon = simd::neonSignalKernels()) {
+            return neon;
+        }
+        if (simd::cpuHasAvx2Fma()) {
+            if (auto* avx2 = simd::avx2SignalKernels()) {
+                return avx2;
+            }
+        }
+    }
+    return &simd::scalarSignalKernels();
+}
+
+uint64_t splitmix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+std::vector<std::string_view> splitList(std::string_view list) {
+    std::vector<std::string_view> items;
+    while (!list.empty()) {
+        const auto comma = list.find(',');
+        auto item = list.substr(0, comma);
+        items.push_back(trim(item));
+        if (comma == std::string_view::npos) {
+            break;
+        }
+        list.remove_prefix(comma + 1);
+    }
+    return items;
+}
+
+} // anonymous namespace
+
+std::optional<Waveform> parseWaveform(std::string_view name) {
+    if (name == "sine") return Waveform::Sine;
+    if (name == "square") return Waveform::Square;
+    if (name == "chirp") return Waveform::Chirp;
+    if (name == "pink" || name == "pink-noise") return Waveform::PinkNoise;
+    if (name == "counter") return Waveform::Counter;
+    return std::nullopt;
+}
+
+const char* toString(Waveform waveform) {
+    switch (waveform) {
+        case Waveform::Square: return "square";
+        case Waveform::Chirp: return "chirp";
+        case Waveform::PinkNoise: return "pink";
+        case Waveform::Counter: return "counter";
+        case Waveform::Sine: break;
+    }
+    return "sine";
+}
+
+std::optional<std::vector<ChannelSignal>> parseChannelSignals(
+    std::string_view waveforms,
+    std::string_view amplitudes,
+    std::string_view frequencies,
+    std::string_view phases,
+    std::string_view end_frequencies
+) {
+    const auto waveform_items = splitList(waveforms);
+    const auto amplitude_items = splitList(amplitudes);
+    const auto frequency_items = splitList(frequencies);
+    const auto phase_items = splitList(phases);
+    const auto end_items = splitList(end_frequencies);
+
+    const std::size_t count = std::max({
+        waveform_items.size(), amplitude_items.size(), frequency_items.size(),
+        phase_items.size(), end_items.size(), std::size_t{1}
+    });
+
+    std::vector<ChannelSignal> signals(count);
+
+    // Apply one list to one field, repeating its last entry
+    auto apply = [&](const std::vector<std::string_view>& items, auto&& assign) {
+        for (std::size_t i = 0; i < count && !items.empty(); ++i) {
+            if (!assign(signals[i], items[std::min(i, items.size() - 1)])) {
+                return false;
+            }
+        }
+        return true;
+    };
+    auto number = [](double ChannelSignal::*field) {
+        return [field](ChannelSignal& signal, std::string_view text) {
+            auto value = parseFiniteNumber(text);
+            if (value) {
+                signal.*field = *value;
+            }
+            return value.has_value();
+        };
+    };
+
+    const bool ok =
+        apply(waveform_items, [](ChannelSignal& signal, std::string_view text) {
+            auto waveform = parseWaveform(text);
+            if (waveform) {
+                signal.waveform = *waveform;
+            }
+            return waveform.has_value();
+        }) &&
+        apply(amplitude_items, number(&ChannelSignal::amplitude)) &&
+        apply(frequency_items, number(&ChannelSignal::frequency)) &&
+        apply(phase_items, number(&ChannelSignal::phase)) &&
+        apply(end_items, number(&ChannelSignal::end_frequency));
+
+    if (!ok) {
+        return std::nullopt;
+    }
+    return signals;
+}
+
+// =============================================================================
+// SignalGenerator
+// =============================================================================
+
+SignalGenerator::SignalGenerator(const Config& config)
+    : config_(config)
+    , channels_(static_cast<std::size_t>(std::max(1, config.channel_count)))
+    , kernels_(selectKernels())
+{
+    // Expand per-channel settings, repeating the last entry
+    const ChannelSignal fallback;
+    signals_.resize(channels_);
+    for (std::size_t c = 0; c < channels_; ++c) {
+        if (config_.channels.empty()) {
+            signals_[c] = fallback;
+        } else {
+            signals_[c] = config_.channels[std::min(c, config_.channels.size() - 1)];
+        }
+    }
+
+    // Group consecutive channels with the same waveform
+    for (std::size_t c = 0; c < channels_; ++c) {
+        if (runs_.empty() || runs_.back().waveform != signals_[c].waveform) {
+            runs_.push_back({signals_[c].waveform, c, 0});
+        }
+        ++runs_.back().count;
+    }
+
+    re_.resize(channels_);
+    im_.resize(channels_);
+    cr_.resize(channels_);
+    ci_.resize(channels_);
+    amplitude_.resize(channels_);
+    value_.resize(channels_);
+    step_.resize(channels_);
+    poles_.resize(7 * channels_);
+    rng_.resize(channels_);
+
+    const double rate = std::max(config_.sample_rate, 1.0);
+    chirp_length_ = std::max<uint64_t>(1, static_cast<uint64_t>(config_.chirp_period * rate));
+
+    reset();
+}
+
+void SignalGenerator::reset() {
+    const double rate = std::max(config_.sample_rate, 1.0);
+    uint64_t seed_state = config_.seed;
+
+    for (std::size_t c = 0; c < channels_; ++c) {
+        const ChannelSignal& signal = signals_[c];
+        const double omega = 2.0 * std::numbers::pi * signal.frequency / rate;
+
+        amplitude_[c] = static_cast<float>(signal.amplitude);
+        re_[c] = static_cast<float>(std::cos(signal.phase));
+        im_[c] = static_cast<float>(std::sin(signal.phase));
+        cr_[c] = static_cast<float>(std::cos(omega));
+        ci_[c] = static_cast<float>(std::sin(omega));
+
+        value_[c] = static_cast<float>(signal.phase);
+        step_[c] = static_cast<float>(signal.amplitude);
+
+        for (int k = 0; k < 7; ++k) {
+            poles_[k * channels_ + c] = 0.0f;
+        }
+        // xorshift32 must not start at zero
+        rng_[c] = static_cast<uint32_t>(splitmix64(seed_state)) | 1u;
+    }
+
+    chirp_position_ = 0;
+    updateChirp();
+}
+
+void SignalGenerator::generate(std::span<float> out) {
+    std::size_t remaining = out.size() / channels_;
+    float* cursor = out.data();
+    std::size_t since_renormalize = 0;
+
+    const bool has_chirp = std::any_of(runs_.begin(), runs_.end(),
+        [](const Run& run) { return run.waveform == Waveform::Chirp; });
+
+    while (remaining > 0) {
+        std::size_t block = std::min(remaining, kBlockSamples);
+        if (has_chirp) {
+            // Stop at the next rotation update or sweep restart
+            const uint64_t to_step = kChirpStep - chirp_position_ % kChirpStep;
+            const uint64_t to_end = chirp_length_ - chirp_position_;
+            block = static_cast<std::size_t>(std::min<uint64_t>({block, to_step, to_end}));
+        }
+
+        generateBlock(cursor, block);
+        cursor += block * channels_;
+        remaining -= block;
+
+        since_renormalize += block;
+        if (since_renormalize >= kBlockSamples) {
+            renormalize();
+            since_renormalize = 0;
+        }
+
+        if (has_chirp) {
+            chirp_position_ += block;
+            if (chirp_position_ >= chirp_length_) {
+                chirp_position_ = 0;
+            }
+            if (chirp_position_ % kChirpStep == 0) {
+                updateChirp();
+            }
+        }
+    }
+
+    renormalize();
+}
+
+const char* SignalGenerator::isa() const {
+    return kernels_->name;
+}
+
+void SignalGenerator::generateBlock(float* out, std::size_t samples) {
+    for (const Run& run : runs_) {
+        const std::size_t c = run.first;
+        float* run_out = out + c;
+
+        switch (run.waveform) {
+            case Waveform::Sine:
+            case Waveform::Chirp:
+            case Waveform::Square: {
+                const simd::OscillatorState state{
+                    re_.data() + c, im_.data() + c, cr_.data() + c, ci_.data() + c,
+                    amplitude_.data() + c
+                };
+                const auto mode = run.waveform == Waveform::Square
+                    ? simd::OscillatorMode::Square
+                    : simd::OscillatorMode::Sine;
+                kernels_->oscillate(run_out, channels_, samples, run.count, mode, state);
+                break;
+            }
+            case Waveform::PinkNoise: {
+                simd::PinkState state{};
+                for (std::size_t k = 0; k < 7; ++k) {
+                    state.poles[k] = poles_.data() + k * channels_ + c;
+                }
+                state.rng = rng_.data() + c;
+                state.amplitude = amplitude_.data() + c;
+                kernels_->pink(run_out, channels_, samples, run.count, state);
+                break;
+            }
+            case Waveform::Counter:
+                kernels_->count(run_out, channels_, samples, run.count,
+                                value_.data() + c, step_.data() + c);
+                break;
+        }
+    }
+}
+
+void SignalGenerator::updateChirp() {
+    const double rate = std::max(config_.sample_rate, 1.0);
+    // Frequency at the centre of the coming step
+    const double progress = (static_cast<double>(chirp_position_) + kChirpStep / 2.0) /
+        static_cast<double>(chirp_length_);
+
+    for (const Run& run : runs_) {
+        if (run.waveform != Waveform::Chirp) {
+            continue;
+        }
+        for (std::size_t c = run.first; c < run.first + run.count; ++c) {
+            const ChannelSignal& signal = signals_[c];
+            const double frequency = signal.frequency +
+                (signal.end_frequency - signal.frequency) * std::min(progress, 1.0);
+            const double omega = 2.0 * std::numbers::pi * frequency / rate;
+            cr_[c] = static_cast<float>(std::cos(omega));
+            ci_[c] = static_cast<float>(std::sin(omega));
+        }
+    }
+}
+
+void SignalGenerator::renormalize() {
+    for (std::size_t c = 0; c < channels_; ++c) {
+        const float magnitude = std::sqrt(re_[c] * re_[c] + im_[c] * im_[c]);
+        if (magnitude > 0.0f) {
+            re_[c] /= magnitude;
+            im_[c] /= magnitude;
+        }
+        if (std::abs(value_[c]) >= kCounterLimit) {
+            value_[c] = static_cast<float>(signals_[c].phase);
+        }
+    }
+}
+
+} // namespace lsltemplate
@@ -0,0 +1,19 @@
+#include "SignalKernelsImpl.hpp"
+
+namespace lsltemplate::simd {
+
+const SignalKernels& scalarSignalKernels() {
+    static constexpr SignalKernels kernels = makeSignalKernels<ScalarOps>("scalar");
+    return kernels;
+}
+
+const SignalKernels* neonSignalKernels() {
+#if defined(LSLTEMPLATE_SIMD_NEON)
+    static constexpr SignalKernels kernels = makeSignalKernels<NeonOps>("neon");
+    return &kernels;
+#else
+    return nullptr;
+#endif
+}
+
+} // namespace lsltemplate::simd
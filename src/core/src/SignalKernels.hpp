@@ -0,0 +1,59 @@
+#pragma once
+/**
+ * @file SignalKernels.hpp
+ * @brief Per-instruction-set kernels behind SignalGenerator (private)
+ *
+ * All kernels write into a channel-interleaved buffer: `out` points at the
+ * first channel of a run of `channels` consecutive channels and consecutive
+ * samples are `stride` floats apart. State arrays are indexed by the same
+ * channel offset and are updated in place.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace lsltemplate::simd {
+
+enum class OscillatorMode {
+    Sine,    ///< amplitude * sin(phase)
+    Square   ///< amplitude * sign(sin(phase))
+};
+
+/// Phasor oscillator: (re, im) is rotated by (cr, ci) every sample
+struct OscillatorState {
+    float* re;
+    float* im;
+    const float* cr;
+    const float* ci;
+    const float* amplitude;
+};
+
+/// Pink noise: xorshift32 white noise through Paul Kellet's 7-pole filter
+struct PinkState {
+    float* poles[7];
+    uint32_t* rng;
+    const float* amplitude;
+};
+
+struct SignalKernels {
+    const char* name;
+    void (*oscillate)(float* out, std::size_t stride, std::size_t samples,
+                      std::size_t channels, OscillatorMode mode,
+                      const OscillatorState& state);
+    void (*count)(float* out, std::size_t stride, std::size_t samples,
+                  std::size_t channels, float* value, const float* step);
+    void (*pink)(float* out, std::size_t stride, std::size_t samples,
+                 std::size_t channels, const PinkState& state);
+};
+
+/// Portable reference kernels
+const SignalKernels& scalarSignalKernels();
+
+/// AVX2/FMA kernels, or nullptr if not built for this target. Only call
+/// after checking the CPU supports AVX2 and FMA.
+const SignalKernels* avx2SignalKernels();
+
+/// NEON kernels, or nullptr if not built for this target
+const SignalKernels* neonSignalKernels();
+
+} // namespace lsltemplate::simd
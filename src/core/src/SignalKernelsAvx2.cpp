@@ -0,0 +1,56 @@
+/**
+ * @file SignalKernelsAvx2.cpp
+ * @brief AVX2/FMA instantiation of the signal kernels
+ *
+ * Compiled for AVX2 via target pragmas rather than global compiler flags, so
+ * the rest of the library (and universal macOS builds) stay baseline x86-64.
+ * Only standard headers without out-of-line functions may be included after
+ * the pragma; see SimdOps.hpp.
+ */
+
+#include "SignalKernels.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2,fma"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+#endif
+
+#define LSLTEMPLATE_SIMD_AVX2 1
+#include "SignalKernelsImpl.hpp"
+
+namespace lsltemplate::simd {
+
+const SignalKernels* avx2SignalKernels() {
+    static constexpr SignalKernels kernels = makeSignalKernels<Avx2Ops>("avx2");
+    return &kernels;
+}
+
+} // namespace lsltemplate::simd
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#else
+
+namespace lsltemplate::simd {
+
+const SignalKernels* avx2SignalKernels() {
+    return nullptr;
+}
+
+} // namespace lsltemplate::simd
+
+#endif
@@ -0,0 +1,132 @@
+#pragma once
+/**
+ * @file SignalKernelsImpl.hpp
+ * @brief Kernel bodies, instantiated once per instruction set (private)
+ *
+ * Include after SimdOps.hpp. Channels are processed Ops::kWidth at a time
+ * with their state held in registers across all samples; leftover channels
+ * fall back to ScalarOps.
+ */
+
+#include "SignalKernels.hpp"
+#include "SimdOps.hpp"
+
+namespace lsltemplate::simd {
+namespace {
+
+template <class Ops>
+void oscillateLanes(float* out, std::size_t stride, std::size_t samples,
+                    OscillatorMode mode, const OscillatorState& st, std::size_t c) {
+    auto re = Ops::load(st.re + c);
+    auto im = Ops::load(st.im + c);
+    const auto cr = Ops::load(st.cr + c);
+    const auto ci = Ops::load(st.ci + c);
+    const auto amp = Ops::load(st.amplitude + c);
+
+    for (std::size_t s = 0; s < samples; ++s) {
+        const auto value = (mode == OscillatorMode::Square) ? Ops::signOf(im) : im;
+        Ops::store(out + s * stride + c, Ops::mul(amp, value));
+        const auto next_re = Ops::fnmadd(im, ci, Ops::mul(re, cr));
+        im = Ops::fmadd(re, ci, Ops::mul(im, cr));
+        re = next_re;
+    }
+
+    Ops::store(st.re + c, re);
+    Ops::store(st.im + c, im);
+}
+
+template <class Ops>
+void oscillate(float* out, std::size_t stride, std::size_t samples, std::size_t channels,
+               OscillatorMode mode, const OscillatorState& state) {
+    std::size_t c = 0;
+    for (; c + Ops::kWidth <= channels; c += Ops::kWidth) {
+        oscillateLanes<Ops>(out, stride, samples, mode, state, c);
+    }
+    for (; c < channels; ++c) {
+        oscillateLanes<ScalarOps>(out, stride, samples, mode, state, c);
+    }
+}
+
+template <class Ops>
+void countLanes(float* out, std::size_t stride, std::size_t samples,
+                float* value, const float* step, std::size_t c) {
+    auto v = Ops::load(value + c);
+    const auto inc = Ops::load(step + c);
+    for (std::size_t s = 0; s < samples; ++s) {
+        Ops::store(out + s * stride + c, v);
+        v = Ops::add(v, inc);
+    }
+    Ops::store(value + c, v);
+}
+
+template <class Ops>
+void count(float* out, std::size_t stride, std::size_t samples, std::size_t channels,
+           float* value, const float* step) {
+    std::size_t c = 0;
+    for (; c + Ops::kWidth <= channels; c += Ops::kWidth) {
+        countLanes<Ops>(out, stride, samples, value, step, c);
+    }
+    for (; c < channels; ++c) {
+        countLanes<ScalarOps>(out, stride, samples, value, step, c);
+    }
+}
+
+template <class Ops>
+void pinkLanes(float* out, std::size_t stride, std::size_t samples,
+               const PinkState& st, std::size_t c) {
+    auto b0 = Ops::load(st.poles[0] + c);
+    auto b1 = Ops::load(st.poles[1] + c);
+    auto b2 = Ops::load(st.poles[2] + c);
+    auto b3 = Ops::load(st.poles[3] + c);
+    auto b4 = Ops::load(st.poles[4] + c);
+    auto b5 = Ops::load(st.poles[5] + c);
+    auto b6 = Ops::load(st.poles[6] + c);
+    auto rng = Ops::loadU(st.rng + c);
+    // Kellet's filter has a gain of roughly 9; scale back to about +-1
+    const auto amp = Ops::mul(Ops::load(st.amplitude + c), Ops::set1(0.11f));
+
+    for (std::size_t s = 0; s < samples; ++s) {
+        rng = Ops::xorshift(rng);
+        const auto white = Ops::toUnit(rng);
+        b0 = Ops::fmadd(Ops::set1(0.99886f), b0, Ops::mul(white, Ops::set1(0.0555179f)));
+        b1 = Ops::fmadd(Ops::set1(0.99332f), b1, Ops::mul(white, Ops::set1(0.0750759f)));
+        b2 = Ops::fmadd(Ops::set1(0.96900f), b2, Ops::mul(white, Ops::set1(0.1538520f)));
+        b3 = Ops::fmadd(Ops::set1(0.86650f), b3, Ops::mul(white, Ops::set1(0.3104856f)));
+        b4 = Ops::fmadd(Ops::set1(0.55000f), b4, Ops::mul(white, Ops::set1(0.5329522f)));
+        b5 = Ops::fnmadd(Ops::set1(0.7616f), b5, Ops::mul(white, Ops::set1(-0.0168980f)));
+        auto pink = Ops::add(Ops::add(Ops::add(b0, b1), Ops::add(b2, b3)),
+                             Ops::add(Ops::add(b4, b5), b6));
+        pink = Ops::fmadd(white, Ops::set1(0.5362f), pink);
+        b6 = Ops::mul(white, Ops::set1(0.115926f));
+        Ops::store(out + s * stride + c, Ops::mul(amp, pink));
+    }
+
+    Ops::store(st.poles[0] + c, b0);
+    Ops::store(st.poles[1] + c, b1);
+    Ops::store(st.poles[2] + c, b2);
+    Ops::store(st.poles[3] + c, b3);
+    Ops::store(st.poles[4] + c, b4);
+    Ops::store(st.poles[5] + c, b5);
+    Ops::store(st.poles[6] + c, b6);
+    Ops::storeU(st.rng + c, rng);
+}
+
+template <class Ops>
+void pink(float* out, std::size_t stride, std::size_t samples, std::size_t channels,
+          const PinkState& state) {
+    std::size_t c = 0;
+    for (; c + Ops::kWidth <= channels; c += Ops::kWidth) {
+        pinkLanes<Ops>(out, stride, samples, state, c);
+    }
+    for (; c < channels; ++c) {
+        pinkLanes<ScalarOps>(out, stride, samples, state, c);
+    }
+}
+
+template <class Ops>
+constexpr SignalKernels makeSignalKernels(const char* name) {
+    return {name, &oscillate<Ops>, &count<Ops>, &pink<Ops>};
+}
+
+} // anonymous namespace
+} // namespace lsltemplate::simd
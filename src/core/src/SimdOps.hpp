@@ -0,0 +1,142 @@
+#pragma once
+/**
+ * @file SimdOps.hpp
+ * @brief Minimal vector-operation wrappers for the SIMD kernels (private)
+ *
+ * Kernels are written once as templates over an Ops struct and instantiated
+ * per instruction set. Everything here has internal linkage so that code
+ * compiled for AVX2 in one translation unit can never be picked by the
+ * linker for a translation unit that must run on any x86-64 CPU.
+ *
+ * ScalarOps is always available. Avx2Ops is only defined in translation
+ * units that define LSLTEMPLATE_SIMD_AVX2 before including this header (see
+ * SignalKernelsAvx2.cpp); NeonOps wherever the compiler targets NEON.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(LSLTEMPLATE_SIMD_AVX2)
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define LSLTEMPLATE_SIMD_NEON 1
+#endif
+
+namespace lsltemplate::simd {
+namespace {
+
+// 2^-31: maps a signed 32-bit integer onto [-1, 1)
+constexpr float kIntToUnit = 4.656612873077393e-10f;
+
+struct ScalarOps {
+    static constexpr std::size_t kWidth = 1;
+    using F = float;
+    using U = uint32_t;
+
+    static F load(const float* p) { return *p; }
+    static void store(float* p, F v) { *p = v; }
+    static F set1(float v) { return v; }
+    static F add(F a, F b) { return a + b; }
+    static F sub(F a, F b) { return a - b; }
+    static F mul(F a, F b) { return a * b; }
+    static F fmadd(F a, F b, F c) { return a * b + c; }   // a * b + c
+    static F fnmadd(F a, F b, F c) { return c - a * b; }  // c - a * b
+    static F signOf(F v) {
+        uint32_t bits;
+        std::memcpy(&bits, &v, sizeof(bits));
+        return (bits >> 31) ? -1.0f : 1.0f;
+    }
+
+    static U loadU(const uint32_t* p) { return *p; }
+    static void storeU(uint32_t* p, U v) { *p = v; }
+    static U xorshift(U x) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        return x;
+    }
+    static F toUnit(U x) {
+        int32_t s;
+        std::memcpy(&s, &x, sizeof(s));
+        return static_cast<float>(s) * kIntToUnit;
+    }
+};
+
+#if defined(LSLTEMPLATE_SIMD_AVX2)
+struct Avx2Ops {
+    static constexpr std::size_t kWidth = 8;
+    using F = __m256;
+    using U = __m256i;
+
+    static F load(const float* p) { return _mm256_loadu_ps(p); }
+    static void store(float* p, F v) { _mm256_storeu_ps(p, v); }
+    static F set1(float v) { return _mm256_set1_ps(v); }
+    static F add(F a, F b) { return _mm256_add_ps(a, b); }
+    static F sub(F a, F b) { return _mm256_sub_ps(a, b); }
+    static F mul(F a, F b) { return _mm256_mul_ps(a, b); }
+    static F fmadd(F a, F b, F c) { return _mm256_fmadd_ps(a, b, c); }
+    static F fnmadd(F a, F b, F c) { return _mm256_fnmadd_ps(a, b, c); }
+    static F signOf(F v) {
+        const F sign_mask = _mm256_set1_ps(-0.0f);
+        return _mm256_or_ps(_mm256_and_ps(v, sign_mask), _mm256_set1_ps(1.0f));
+    }
+
+    static U loadU(const uint32_t* p) {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    }
+    static void storeU(uint32_t* p, U v) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+    }
+    static U xorshift(U x) {
+        x = _mm256_xor_si256(x, _mm256_slli_epi32(x, 13));
+        x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 17));
+        x = _mm256_xor_si256(x, _mm256_slli_epi32(x, 5));
+        return x;
+    }
+    static F toUnit(U x) {
+        return _mm256_mul_ps(_mm256_cvtepi32_ps(x), _mm256_set1_ps(kIntToUnit));
+    }
+};
+#endif
+
+#if defined(LSLTEMPLATE_SIMD_NEON)
+struct NeonOps {
+    static constexpr std::size_t kWidth = 4;
+    using F = float32x4_t;
+    using U = uint32x4_t;
+
+    static F load(const float* p) { return vld1q_f32(p); }
+    static void store(float* p, F v) { vst1q_f32(p, v); }
+    static F set1(float v) { return vdupq_n_f32(v); }
+    static F add(F a, F b) { return vaddq_f32(a, b); }
+    static F sub(F a, F b) { return vsubq_f32(a, b); }
+    static F mul(F a, F b) { return vmulq_f32(a, b); }
+    static F fmadd(F a, F b, F c) { return vfmaq_f32(c, a, b); }
+    static F fnmadd(F a, F b, F c) { return vfmsq_f32(c, a, b); }
+    static F signOf(F v) {
+        const U sign_mask = vdupq_n_u32(0x80000000u);
+        return vreinterpretq_f32_u32(vorrq_u32(
+            vandq_u32(vreinterpretq_u32_f32(v), sign_mask),
+            vreinterpretq_u32_f32(vdupq_n_f32(1.0f))));
+    }
+
+    static U loadU(const uint32_t* p) { return vld1q_u32(p); }
+    static void storeU(uint32_t* p, U v) { vst1q_u32(p, v); }
+    static U xorshift(U x) {
+        x = veorq_u32(x, vshlq_n_u32(x, 13));
+        x = veorq_u32(x, vshrq_n_u32(x, 17));
+        x = veorq_u32(x, vshlq_n_u32(x, 5));
+        return x;
+    }
+    static F toUnit(U x) {
+        return vmulq_n_f32(vcvtq_f32_s32(vreinterpretq_s32_u32(x)), kIntToUnit);
+    }
+};
+#endif
+
+} // anonymous namespace
+} // namespace lsltemplate::simd
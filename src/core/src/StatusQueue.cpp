@@ -0,0 +1,198 @@
+#include "lsltemplate/StatusQueue.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace lsltemplate {
+
+namespace {
+
+std::size_t roundUpToPowerOfTwo(std::size_t value) {
+    std::size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+} // anonymous namespace
+
+StatusQueue::StatusQueue(StatusCallback callback)
+    : StatusQueue(Config{}, std::move(callback))
+{
+}
+
+StatusQueue::StatusQueue(const Config& config, StatusCallback callback)
+    : config_(config)
+    , callback_(std::move(callback))
+{
+    if (!callback_) {
+        return;
+    }
+    const std::size_t capacity = roundUpToPowerOfTwo(std::max<std::size_t>(2, config_.capacity));
+    slots_ = std::make_unique<Slot[]>(capacity);
+    mask_ = capacity - 1;
+    for (std::size_t i = 0; i < capacity; ++i) {
+        slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    thread_ = std::thread(&StatusQueue::drainFunction, this);
+}
+
+StatusQueue::~StatusQueue() {
+    if (thread_.joinable()) {
+        shutdown_.store(true, std::memory_order_release);
+        thread_.join();
+    }
+}
+
+StatusCallback StatusQueue::callback() {
+    if (!callback_) {
+        return nullptr;
+    }
+    return [this](const std::string& message, bool is_error) {
+        post(is_error, message);
+    };
+}
+
+void StatusQueue::flush() {
+    if (!thread_.joinable()) {
+        return;
+    }
+    const uint64_t ticket = flush_requests_.fetch_add(1, std::memory_order_acq_rel) + 1;
+    while (flushed_.load(std::memory_order_acquire) < ticket) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+void StatusQueue::appendText(Slot& slot, std::string_view text) {
+    const std::size_t length = std::min(text.size(), kMaxLength - slot.length);
+    std::memcpy(slot.text + slot.length, text.data(), length);
+    slot.length = static_cast<std::uint16_t>(slot.length + length);
+}
+
+void StatusQueue::appendNumber(Slot& slot, double value) {
+    char buffer[32];
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    const std::size_t length = static_cast<std::size_t>(result.ptr - buffer);
+#else
+    const int written = std::snprintf(buffer, sizeof(buffer), "%g", value);
+    const std::size_t length = written > 0
+        ? std::min(static_cast<std::size_t>(written), sizeof(buffer) - 1) : 0;
+#endif
+    appendText(slot, std::string_view(buffer, length));
+}
+
+StatusQueue::Slot* StatusQueue::claim() {
+    // Bounded MPMC ring after Vyukov: a slot is free for position pos when
+    // its sequence equals pos, and holds a message once it is pos + 1
+    std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    while (true) {
+        Slot& slot = slots_[pos & mask_];
+        const std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        const auto difference =
+            static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+        if (difference == 0) {
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                return &slot;
+            }
+        } else if (difference < 0) {
+            overflowed_.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        } else {
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void StatusQueue::publish(Slot& slot) {
+    const std::size_t pos = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(pos + 1, std::memory_order_release);
+}
+
+void StatusQueue::drainFunction() {
+    using Clock = std::chrono::steady_clock;
+
+    std::string last;            // Last message passed on, for coalescing
+    bool last_is_error = false;
+    uint64_t repeats = 0;        // Of last, not yet reported
+    uint64_t rate_limited = 0;   // Not yet reported
+    uint64_t overflow_reported = 0;
+    double tokens = static_cast<double>(config_.burst);
+    auto refilled = Clock::now();
+    auto next_summary = refilled + config_.summary_interval;
+    std::string message;
+
+    const auto reportRepeats = [&] {
+        if (repeats > 0) {
+            callback_(last + " (repeated " + std::to_string(repeats) + " more times)", last_is_error);
+            repeats = 0;
+        }
+    };
+    const auto reportDropped = [&] {
+        const uint64_t overflowed = overflowed_.load(std::memory_order_relaxed);
+        const uint64_t dropped = overflowed - overflow_reported + rate_limited;
+        if (dropped > 0) {
+            callback_(std::to_string(dropped) + " status messages dropped", true);
+            overflow_reported = overflowed;
+            rate_limited = 0;
+        }
+    };
+
+    while (true) {
+        const bool stopping = shutdown_.load(std::memory_order_acquire);
+        const uint64_t requested = flush_requests_.load(std::memory_order_acquire);
+
+        const auto now = Clock::now();
+        if (config_.max_rate > 0) {
+            tokens = std::min(static_cast<double>(config_.burst),
+                              tokens + std::chrono::duration<double>(now - refilled).count() *
+                                  config_.max_rate);
+        }
+        refilled = now;
+
+        while (true) {
+            Slot& slot = slots_[dequeue_pos_ & mask_];
+            if (slot.sequence.load(std::memory_order_acquire) != dequeue_pos_ + 1) {
+                break;
+            }
+            message.assign(slot.text, slot.length);
+            const bool is_error = slot.is_error;
+            slot.sequence.store(dequeue_pos_ + mask_ + 1, std::memory_order_release);
+            ++dequeue_pos_;
+
+            if (message == last && is_error == last_is_error) {
+                ++repeats;
+                continue;
+            }
+            reportRepeats();
+            if (config_.max_rate > 0) {
+                if (tokens < 1.0) {
+                    ++rate_limited;
+                    continue;
+                }
+                tokens -= 1.0;
+            }
+            callback_(message, is_error);
+            last = message;
+            last_is_error = is_error;
+        }
+
+        if (stopping || requested != flushed_.load(std::memory_order_relaxed) || now >= next_summary) {
+            // A message that stopped repeating is reported again next time
+            if (repeats == 0) {
+                last.clear();
+            }
+            reportRepeats();
+            reportDropped();
+            next_summary = now + config_.summary_interval;
+        }
+        flushed_.store(requested, std::memory_order_release);
+        if (stopping) {
+            break;
+        }
+        std::this_thread::sleep_for(config_.drain_interval);
+    }
+}
+
+} // namespace lsltemplate
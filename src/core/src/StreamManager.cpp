@@ -0,0 +1,403 @@
+#include "lsltemplate/StreamManager.hpp"
+#include "lsltemplate/LSLOutlet.hpp"
+#include "lsltemplate/PrerollBuffer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <span>
+#include <string>
+#include <type_traits>
+
+namespace lsltemplate {
+
+namespace {
+
+std::size_t defaultWorkers() {
+    const unsigned hardware = std::thread::hardware_concurrency();
+    return std::clamp<std::size_t>(hardware, 1, 4);
+}
+
+} // anonymous namespace
+
+struct StreamManager::Stream {
+    std::unique_ptr<IDevice> device;
+    DeviceInfo info;
+    std::unique_ptr<LSLOutlet> outlet;
+    Recorder::Config recording;
+    std::unique_ptr<Recorder> recorder;
+    std::vector<FilterSpec> filters;
+    std::vector<ChannelDescription> channel_layout;
+    std::function<std::size_t()> pump;  // Read what is ready, push it; samples, kReadError or kEndOfData
+    std::size_t capacity = 1;           // Samples per read
+
+    bool started = false;     // Between start() and stop(); guarded by control_mutex_
+    bool active = false;      // Scheduled for polling
+    bool in_flight = false;   // A worker is inside pump()
+    uint64_t generation = 0;  // Invalidates heap entries of earlier runs
+    Clock::time_point due;    // Current poll deadline
+};
+
+StreamManager::StreamManager(StatusCallback callback)
+    : StreamManager(Config{}, std::move(callback))
+{
+}
+
+StreamManager::StreamManager(const Config& config, StatusCallback callback)
+    : config_(config)
+    , statusCallback_(std::move(callback))
+    , status_(statusCallback_)
+{
+    if (config_.lock_memory) {
+        lockMemory(statusCallback_);
+    }
+
+    const std::size_t workers = config_.workers > 0 ? config_.workers : defaultWorkers();
+    workers_.reserve(workers);
+    for (std::size_t i = 0; i < workers; ++i) {
+        workers_.emplace_back(&StreamManager::workerFunction, this);
+    }
+}
+
+StreamManager::~StreamManager() {
+    stopAll();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shutdown_ = true;
+    }
+    wake_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+StreamManager::StreamId StreamManager::add(
+    std::unique_ptr<IDevice> device,
+    const Recorder::Config& recording,
+    const std::vector<FilterSpec>& filters,
+    const std::vector<ChannelDescription>& channel_layout
+) {
+    auto stream = std::make_unique<Stream>();
+    stream->device = std::move(device);
+    stream->recording = recording;
+    stream->filters = filters;
+    stream->channel_layout = channel_layout;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    streams_.push_back(std::move(stream));
+    return streams_.size() - 1;
+}
+
+bool StreamManager::start(StreamId id) {
+    std::lock_guard<std::mutex> control(control_mutex_);
+
+    Stream* stream = nullptr;
+    bool failed = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (id >= streams_.size()) {
+            return false;
+        }
+        stream = streams_[id].get();
+        // A worker takes a stream off the schedule when its device fails
+        // or runs out of data, and leaves the teardown to the next start()
+        failed = stream->started && !stream->active;
+    }
+    if (failed) {
+        status_.flush();  // The failure is reported before the restart
+        teardown(*stream);
+    }
+    if (stream->started || !stream->device) {
+        return false;
+    }
+
+    // Not scheduled, so no worker touches the stream while it is set up
+    if (!stream->device->connect()) {
+        report("Failed to connect to device", true);
+        return false;
+    }
+    stream->info = stream->device->getInfo();
+    if (!stream->channel_layout.empty()) {
+        if (stream->channel_layout.size() != static_cast<std::size_t>(stream->info.channel_count)) {
+            stream->device->disconnect();
+            report("Channel layout lists " + std::to_string(stream->channel_layout.size()) +
+                   " channels for " + stream->info.name + " (" +
+                   std::to_string(stream->info.channel_count) + " channels)", true);
+            return false;
+        }
+        stream->info.channel_layout = stream->channel_layout;
+    }
+
+    try {
+        stream->outlet = std::make_unique<LSLOutlet>(stream->info);
+    } catch (const std::exception& e) {
+        stream->device->disconnect();
+        report(std::string("Failed to create outlet: ") + e.what(), true);
+        return false;
+    }
+
+    // Shared, like the pre-roll buffer below
+    std::shared_ptr<FilterChain> filters;
+    if (!stream->filters.empty()) {
+        filters = std::make_shared<FilterChain>(
+            stream->filters, stream->info.format, stream->info.sample_rate,
+            static_cast<std::size_t>(std::max(1, stream->info.channel_count)));
+        if (!filters->isValid()) {
+            stream->outlet.reset();
+            stream->device->disconnect();
+            report("Invalid filters for " + stream->info.name + ": " + filters->error(), true);
+            return false;
+        }
+    }
+
+    // Room for two poll intervals, so a late poll does not lose data
+    const double interval = std::chrono::duration<double>(config_.poll_interval).count();
+    const std::size_t channels = static_cast<std::size_t>(std::max(1, stream->info.channel_count));
+    const std::size_t capacity = std::max<std::size_t>(
+        1, static_cast<std::size_t>(std::ceil(stream->info.sample_rate * 2.0 * interval)));
+
+    if (!stream->recording.path.empty()) {
+        stream->recorder = std::make_unique<Recorder>(
+            stream->recording, stream->info, capacity, statusCallback_);
+        if (!stream->recorder->start()) {
+            stream->recorder.reset();
+            stream->outlet.reset();
+            stream->device->disconnect();
+            return false;
+        }
+    }
+
+    stream->capacity = capacity;
+    const double srate = stream->info.sample_rate;
+    const double sample_interval = srate > 0 ? 1.0 / srate : 0.0;
+    const bool gate = config_.gate_on_consumers;
+    // Device-clock timestamps need StreamThread's clock mapping: stamp on arrival
+    const bool device_clock = stream->info.timestamp_clock == TimestampClock::Device;
+    visitSampleFormat(stream->info.format, [&]<typename T>() {
+        // Shared so the pump stays copyable for std::function
+        auto preroll = std::make_shared<PrerollBuffer<T>>(
+            gate ? prerollCapacity(srate, config_.preroll) : 0, channels);
+        stream->pump = [stream, channels, sample_interval, gate, device_clock, preroll, filters,
+                        buffer = std::vector<T>(capacity * channels)]() mutable {
+            double timestamp = 0.0;
+            std::size_t samples = stream->device->getData(std::span<T>(buffer), timestamp);
+            if (samples == IDevice::kReadError || samples == IDevice::kEndOfData || samples == 0) {
+                return samples;
+            }
+            samples = std::min(samples, buffer.size() / channels);
+            if (device_clock) {
+                timestamp = 0.0;
+            }
+            if constexpr (std::is_floating_point_v<T>) {
+                if (filters) {
+                    filters->process(buffer.data(), samples);
+                }
+            }
+
+            // Kept samples need the timestamp liblsl would have assigned
+            if ((stream->recorder || gate) && timestamp == 0.0) {
+                timestamp = lsl::local_clock();
+            }
+            if (stream->recorder) {
+                stream->recorder->record(buffer.data(), samples, timestamp, sample_interval);
+            }
+            if (gate) {
+                if (!stream->outlet->hasConsumers()) {
+                    preroll->append(buffer.data(), samples, timestamp, sample_interval);
+                    return samples;
+                }
+                preroll->drain([&](const T* data, const double* timestamps, std::size_t n) {
+                    stream->outlet->pushChunk(data, timestamps, n * channels);
+                });
+            }
+            stream->outlet->pushChunk(buffer.data(), samples * channels, timestamp);
+            return samples;
+        };
+    });
+    stream->started = true;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stream->active = true;
+        ++stream->generation;
+        stream->due = Clock::now();
+        schedule_.push({stream->due, id, stream->generation});
+    }
+    wake_.notify_one();
+
+    report("Streaming started: " + stream->info.name, false);
+    return true;
+}
+
+void StreamManager::stop(StreamId id) {
+    std::lock_guard<std::mutex> control(control_mutex_);
+
+    Stream* stream = nullptr;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (id >= streams_.size() || !streams_[id]->started) {
+            return;
+        }
+        stream = streams_[id].get();
+
+        // Orphan its heap entry and let an in-progress poll finish
+        stream->active = false;
+        ++stream->generation;
+        idle_.wait(lock, [stream]() { return !stream->in_flight; });
+    }
+    status_.flush();  // Worker reports come first
+
+    teardown(*stream);
+}
+
+void StreamManager::teardown(Stream& stream) {
+    stream.outlet.reset();
+    stream.device->disconnect();
+    stream.pump = nullptr;
+    stream.started = false;
+
+    if (stream.recorder) {
+        stream.recorder->stop();
+        const auto stats = stream.recorder->stats();
+        report("Recorded " + std::to_string(stats.samples) + " samples of " + stream.info.name +
+               ", " + std::to_string(stats.dropped) + " chunks dropped", false);
+        stream.recorder.reset();
+    }
+
+    report("Streaming stopped: " + stream.info.name, false);
+}
+
+bool StreamManager::startAll() {
+    bool all_started = true;
+    for (StreamId id = 0; id < size(); ++id) {
+        if (!isRunning(id)) {
+            all_started = start(id) && all_started;
+        }
+    }
+    return all_started;
+}
+
+void StreamManager::stopAll() {
+    std::lock_guard<std::mutex> control(control_mutex_);
+
+    // Take every stream off the schedule first, so the polls still in
+    // progress finish concurrently instead of one stop() after another
+    std::vector<Stream*> stopping;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (const auto& stream : streams_) {
+            if (stream->started) {
+                stream->active = false;
+                ++stream->generation;
+                stopping.push_back(stream.get());
+            }
+        }
+        idle_.wait(lock, [&stopping]() {
+            return std::none_of(stopping.begin(), stopping.end(),
+                                [](const Stream* stream) { return stream->in_flight; });
+        });
+    }
+    status_.flush();
+
+    for (Stream* stream : stopping) {
+        teardown(*stream);
+    }
+}
+
+bool StreamManager::isRunning(StreamId id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return id < streams_.size() && streams_[id]->active;
+}
+
+std::size_t StreamManager::runningCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<std::size_t>(std::count_if(streams_.begin(), streams_.end(),
+        [](const auto& stream) { return stream->active; }));
+}
+
+std::size_t StreamManager::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return streams_.size();
+}
+
+DeviceInfo StreamManager::getDeviceInfo(StreamId id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (id >= streams_.size() || !streams_[id]->device) {
+        return {};
+    }
+    return streams_[id]->device->getInfo();
+}
+
+void StreamManager::workerFunction() {
+    applyThreadScheduling(config_.scheduling, "worker", status_.callback());
+    if (config_.lock_memory) {
+        prefaultStack();
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (!shutdown_) {
+        if (schedule_.empty()) {
+            wake_.wait(lock);
+            continue;
+        }
+
+        const Deadline next = schedule_.top();
+        Stream& stream = *streams_[next.id];
+        if (!stream.active || next.generation != stream.generation) {
+            schedule_.pop();  // Stopped or restarted since it was scheduled
+            continue;
+        }
+        if (Clock::now() < next.due) {
+            // Woken early when an earlier deadline is pushed
+            wake_.wait_until(lock, next.due);
+            continue;
+        }
+        schedule_.pop();
+        stream.in_flight = true;
+        lock.unlock();
+
+        std::size_t samples = IDevice::kReadError;
+        bool failed = false;  // Or ended: either way the stream is taken off the schedule
+        try {
+            samples = stream.pump();
+            if (samples == IDevice::kEndOfData) {
+                failed = true;
+                status_.info("Device has no more data: ", stream.info.name);
+            } else if (samples == IDevice::kReadError) {
+                failed = true;
+                status_.error("Device acquisition error: ", stream.info.name);
+            }
+        } catch (const std::exception& e) {
+            failed = true;
+            status_.error("Streaming error: ", stream.info.name, ": ", e.what());
+        }
+
+        lock.lock();
+        stream.in_flight = false;
+        if (failed) {
+            stream.active = false;
+        } else if (stream.active && next.generation == stream.generation) {
+            const auto now = Clock::now();
+            if (samples >= stream.capacity) {
+                stream.due = now;  // Buffer was full: more is waiting
+            } else {
+                // Fixed cadence; skip missed slots rather than bursting
+                stream.due += config_.poll_interval;
+                if (stream.due < now) {
+                    stream.due = now + config_.poll_interval;
+                }
+            }
+            schedule_.push({stream.due, next.id, stream.generation});
+        }
+        idle_.notify_all();
+    }
+}
+
+void StreamManager::report(const std::string& message, bool is_error) {
+    if (statusCallback_) {
+        statusCallback_(message, is_error);
+    }
+}
+
+} // namespace lsltemplate
@@ -0,0 +1,99 @@
+#include "lsltemplate/StreamStats.hpp"
+
+namespace lsltemplate {
+
+void StatsRecorder::reset() {
+    auto clear = [](Buckets& buckets) {
+        for (auto& count : buckets) {
+            count.store(0, std::memory_order_relaxed);
+        }
+    };
+
+    acquisition_.read_calls.store(0, std::memory_order_relaxed);
+    acquisition_.overruns.store(0, std::memory_order_relaxed);
+    acquisition_.chunk_samples.store(0, std::memory_order_relaxed);
+    acquisition_.reconnects.store(0, std::memory_order_relaxed);
+    acquisition_.samples_missed.store(0, std::memory_order_relaxed);
+    acquisition_.last_data.store(0, std::memory_order_relaxed);
+    acquisition_.stalls.store(0, std::memory_order_relaxed);
+    acquisition_.delivered_rate.store(0.0, std::memory_order_relaxed);
+    acquisition_.rate_deviating.store(false, std::memory_order_relaxed);
+    clear(acquisition_.get_data);
+    clear(acquisition_.recovery);
+
+    publisher_.samples.store(0, std::memory_order_relaxed);
+    publisher_.chunks.store(0, std::memory_order_relaxed);
+    publisher_.bytes.store(0, std::memory_order_relaxed);
+    publisher_.consumer_changes.store(0, std::memory_order_relaxed);
+    publisher_.has_consumers.store(false, std::memory_order_relaxed);
+    publisher_.gated.store(0, std::memory_order_relaxed);
+    publisher_.discarded.store(0, std::memory_order_relaxed);
+    clear(publisher_.push_chunk);
+
+    started_.store(Clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+}
+
+void StatsRecorder::recordRead(Clock::duration duration) {
+    bump(acquisition_.read_calls);
+    record(acquisition_.get_data, duration);
+}
+
+void StatsRecorder::recordReconnect(Clock::duration recovery, uint64_t samples_missed) {
+    bump(acquisition_.reconnects);
+    bump(acquisition_.samples_missed, samples_missed);
+    record(acquisition_.recovery, recovery);
+}
+
+void StatsRecorder::recordPush(uint64_t samples, uint64_t bytes, Clock::duration duration) {
+    bump(publisher_.samples, samples);
+    bump(publisher_.chunks);
+    bump(publisher_.bytes, bytes);
+    record(publisher_.push_chunk, duration);
+}
+
+void StatsRecorder::recordConsumers(bool has_consumers) {
+    if (publisher_.has_consumers.load(std::memory_order_relaxed) != has_consumers) {
+        publisher_.has_consumers.store(has_consumers, std::memory_order_relaxed);
+        bump(publisher_.consumer_changes);
+    }
+}
+
+void StatsRecorder::record(Buckets& buckets, Clock::duration duration) {
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+    bump(buckets[DurationHistogram::bucketOf(ns > 0 ? static_cast<uint64_t>(ns) : 0)]);
+}
+
+StreamStats StatsRecorder::snapshot() const {
+    StreamStats stats;
+    const Clock::duration elapsed = Clock::now() - started();
+    stats.elapsed = std::chrono::duration<double>(elapsed).count();
+    stats.samples_pushed = publisher_.samples.load(std::memory_order_relaxed);
+    stats.chunks_pushed = publisher_.chunks.load(std::memory_order_relaxed);
+    stats.bytes_pushed = publisher_.bytes.load(std::memory_order_relaxed);
+    stats.read_calls = acquisition_.read_calls.load(std::memory_order_relaxed);
+    stats.overruns = acquisition_.overruns.load(std::memory_order_relaxed);
+    stats.chunk_samples = acquisition_.chunk_samples.load(std::memory_order_relaxed);
+    stats.reconnects = acquisition_.reconnects.load(std::memory_order_relaxed);
+    stats.samples_missed = acquisition_.samples_missed.load(std::memory_order_relaxed);
+    stats.delivered_rate = acquisition_.delivered_rate.load(std::memory_order_relaxed);
+    stats.rate_deviating = acquisition_.rate_deviating.load(std::memory_order_relaxed);
+    stats.stalls = acquisition_.stalls.load(std::memory_order_relaxed);
+    stats.since_data = std::chrono::duration<double>(
+        elapsed - Clock::duration(acquisition_.last_data.load(std::memory_order_relaxed))).count();
+    stats.consumer_changes = publisher_.consumer_changes.load(std::memory_order_relaxed);
+    stats.has_consumers = publisher_.has_consumers.load(std::memory_order_relaxed);
+    stats.samples_gated = publisher_.gated.load(std::memory_order_relaxed);
+    stats.preroll_discarded = publisher_.discarded.load(std::memory_order_relaxed);
+    stats.effective_rate = stats.elapsed > 0.0
+        ? static_cast<double>(stats.samples_pushed) / stats.elapsed
+        : 0.0;
+
+    for (std::size_t i = 0; i < DurationHistogram::kBuckets; ++i) {
+        stats.get_data.counts[i] = acquisition_.get_data[i].load(std::memory_order_relaxed);
+        stats.push_chunk.counts[i] = publisher_.push_chunk[i].load(std::memory_order_relaxed);
+        stats.recovery.counts[i] = acquisition_.recovery[i].load(std::memory_order_relaxed);
+    }
+    return stats;
+}
+
+} // namespace lsltemplate
@@ -1,14 +1,123 @@
 #include "lsltemplate/StreamThread.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <iostream>
+#include <optional>
+#include <string>
+#include <type_traits>
 
 namespace lsltemplate {
 
+namespace {
+
+// Samples in the given duration, minimum 1 sample
+std::size_t chunkSamples(const DeviceInfo& info, double duration) {
+    return std::max(1, static_cast<int>(info.sample_rate * duration));
+}
+
+// Seconds of data in a read of `samples` at the nominal rate
+double chunkPeriod(const DeviceInfo& info, std::size_t samples) {
+    return info.sample_rate > 0 ? static_cast<double>(samples) / info.sample_rate : 0.0;
+}
+
+// Adaptive chunking: re-evaluate after this much data, and only act on
+// changes larger than the dead band (chunk size moves at most 2x per step)
+constexpr double kAdaptInterval = 0.5;
+constexpr double kAdaptDeadBand = 0.2;
+
+// stop() reports joins slower than this
+constexpr auto kSlowStop = std::chrono::milliseconds(100);
+
+// Largest ChunkRing start() allocates; more is a configuration mistake
+constexpr std::size_t kMaxRingCapacity = std::size_t{1} << 20;
+
+// Smoothing of the measured pushChunk() cost
+constexpr double kPushCostSmoothing = 0.1;
+
+// Payload size of pushed values (string lengths for strings)
+template <typename T>
+uint64_t payloadBytes(const T* data, std::size_t elements) {
+    if constexpr (std::is_same_v<T, std::string>) {
+        uint64_t bytes = 0;
+        for (std::size_t i = 0; i < elements; ++i) {
+            bytes += data[i].size();
+        }
+        return bytes;
+    } else {
+        return elements * sizeof(T);
+    }
+}
+
+// Why the stream cannot be decimated, or empty if it can
+std::string decimationError(const DeviceInfo& info) {
+    if (info.format != SampleFormat::Float32 && info.format != SampleFormat::Double64) {
+        return std::string("Decimation needs a float32 or double64 stream, not ") +
+            toString(info.format);
+    }
+    if (info.sample_rate <= 0) {
+        return "Decimation needs a regular sample rate";
+    }
+    return {};
+}
+
+// Stream description of the copy decimated by factor
+DeviceInfo derivedInfo(const DeviceInfo& parent, std::size_t factor) {
+    const std::string suffix = "_dec" + std::to_string(factor);
+    DeviceInfo info = parent;
+    info.name = parent.name + suffix;
+    info.source_id = (parent.source_id.empty() ? parent.name : parent.source_id) + suffix;
+    info.sample_rate = parent.sample_rate / static_cast<double>(factor);
+    return info;
+}
+
+constexpr std::size_t kNoParent = static_cast<std::size_t>(-1);
+
+} // anonymous namespace
+
+/**
+ * @brief Outlet publishing the stream decimated by `factor`
+ */
+struct StreamThread::DerivedOutlet {
+    std::size_t factor = 1;           // Relative to the device rate
+    std::size_t parent = kNoParent;   // derived_ entry whose output is the input
+    std::unique_ptr<DecimatorBase> decimator;
+    std::unique_ptr<LSLOutlet> outlet;
+    std::vector<double> times;        // Timestamps of the last outputs
+    double sample_interval = 0.0;     // Spacing of the outputs
+};
+
+/**
+ * @brief Settings changed by update() that the acquisition thread swaps in
+ *
+ * After the swap it holds the replaced filters until update() or stop()
+ * frees them, so nothing is deallocated on the acquisition thread.
+ */
+struct StreamThread::PendingUpdate {
+    bool replace_filters = false;
+    std::unique_ptr<FilterChain> filters;  // nullptr = no filtering
+    std::size_t chunk_samples = 0;         // 0 = unchanged
+    std::optional<int> device_parameter;
+};
+
 StreamThread::StreamThread(
     std::unique_ptr<IDevice> device,
     StatusCallback callback
+)
+    : StreamThread(std::move(device), Config{}, std::move(callback))
+{
+}
+
+StreamThread::StreamThread(
+    std::unique_ptr<IDevice> device,
+    const Config& config,
+    StatusCallback callback
 )
     : device_(std::move(device))
+    , config_(config)
+    , pacer_({})
     , statusCallback_(std::move(callback))
+    , status_(statusCallback_)
 {
 }
 
@@ -20,6 +129,7 @@ bool StreamThread::start() {
     if (running_) {
         return false;  // Already running
     }
+    stop();  // Reap a thread that ended on its own
 
     if (!device_) {
         if (statusCallback_) {
@@ -27,6 +137,23 @@ bool StreamThread::start() {
         }
         return false;
     }
+    if (config_.decoupled && (config_.ring_capacity < 1 || config_.ring_capacity > kMaxRingCapacity)) {
+        if (statusCallback_) {
+            statusCallback_("Invalid ring capacity " + std::to_string(config_.ring_capacity) +
+                            " (1 to " + std::to_string(kMaxRingCapacity) + " chunks)", true);
+        }
+        return false;
+    }
+    // A delay of 0 would never grow, and retry connect() in a tight loop
+    if (config_.reconnect &&
+        (!(config_.reconnect_delay > 0.0) || !(config_.reconnect_max_delay >= config_.reconnect_delay))) {
+        if (statusCallback_) {
+            statusCallback_("Invalid reconnect delays " + std::to_string(config_.reconnect_delay) + " s to " +
+                            std::to_string(config_.reconnect_max_delay) +
+                            " s (the first must be positive and at most the longest)", true);
+        }
+        return false;
+    }
 
     // Connect to device
     if (!device_->connect()) {
@@ -36,10 +163,147 @@ bool StreamThread::start() {
         return false;
     }
 
+    info_ = device_->getInfo();
+    if (!config_.channel_layout.empty()) {
+        if (config_.channel_layout.size() != static_cast<std::size_t>(info_.channel_count)) {
+            if (statusCallback_) {
+                statusCallback_("Channel layout lists " + std::to_string(config_.channel_layout.size()) +
+                                " channels for a " + std::to_string(info_.channel_count) +
+                                "-channel stream", true);
+            }
+            device_->disconnect();
+            return false;
+        }
+        info_.channel_layout = config_.channel_layout;
+    }
+
+    // Before the buffers below are allocated, so they are locked as well
+    if (config_.lock_memory) {
+        lockMemory(statusCallback_);
+    }
+
+    max_chunk_samples_ = chunkSamples(info_, config_.chunk_duration);
+    chunk_samples_ = config_.adaptive_chunk
+        ? std::min(max_chunk_samples_, chunkSamples(info_, config_.latency_target))
+        : max_chunk_samples_;
+    samples_since_adapt_ = 0;
+    push_cost_ = 0.0;
+
+    rate_monitor_ = std::make_unique<RateMonitor>(
+        config_.rate_monitor, info_.sample_rate, chunkPeriod(info_, chunk_samples_));
+    if (!rate_monitor_->enabled()) {
+        rate_monitor_.reset();
+    }
+
+    // The ring outlives the threads so its counters stay readable after stop()
+    if (config_.decoupled) {
+        visitSampleFormat(info_.format, [&]<typename T>() {
+            ring_ = std::make_unique<ChunkRing<T>>(
+                config_.ring_capacity,
+                max_chunk_samples_ * info_.channel_count,
+                config_.overflow_policy
+            );
+        });
+    } else {
+        ring_.reset();
+    }
+
+    filters_.reset();
+    if (!config_.filters.empty()) {
+        filters_ = std::make_unique<FilterChain>(config_.filters, info_.format, info_.sample_rate,
+                                                 static_cast<std::size_t>(info_.channel_count));
+        if (!filters_->isValid()) {
+            if (statusCallback_) {
+                statusCallback_("Invalid filters: " + filters_->error(), true);
+            }
+            filters_.reset();
+            device_->disconnect();
+            return false;
+        }
+        if (statusCallback_) {
+            statusCallback_("Filtering with " + std::to_string(filters_->stages()) +
+                            " biquad stages (" + filters_->isa() + ")", false);
+        }
+    }
+
+    if (!config_.decimation.empty()) {
+        const std::string error = decimationError(info_);
+        if (!error.empty()) {
+            if (statusCallback_) {
+                statusCallback_(error, true);
+            }
+            filters_.reset();
+            device_->disconnect();
+            return false;
+        }
+    }
+    splitter_.reset();
+    if (!config_.splits.empty()) {
+        const std::string error = validateSplits(config_.splits, info_.channel_count);
+        if (!error.empty()) {
+            if (statusCallback_) {
+                statusCallback_("Invalid channel split: " + error, true);
+            }
+            filters_.reset();
+            device_->disconnect();
+            return false;
+        }
+        visitSampleFormat(info_.format, [&]<typename T>() {
+            splitter_ = std::make_unique<ChannelSplitter<T>>(
+                config_.splits, static_cast<std::size_t>(info_.channel_count), max_chunk_samples_);
+        });
+    }
+    input_times_.assign(max_chunk_samples_, 0.0);
+
+    recorder_.reset();
+    if (!config_.recording.path.empty()) {
+        recorder_ = std::make_unique<Recorder>(
+            config_.recording, info_, max_chunk_samples_, statusCallback_);
+        if (!recorder_->start()) {
+            recorder_.reset();
+            device_->disconnect();
+            return false;
+        }
+    }
+
+    preview_.reset();
+    if (config_.preview.columns > 0 && info_.format != SampleFormat::String) {
+        preview_ = std::make_unique<PreviewBuffer>(
+            config_.preview, static_cast<std::size_t>(info_.channel_count), info_.sample_rate);
+    }
+
+    if (config_.gate_on_consumers) {
+        visitSampleFormat(info_.format, [&]<typename T>() {
+            preroll_ = std::make_unique<PrerollBuffer<T>>(
+                prerollCapacity(info_.sample_rate, config_.preroll),
+                static_cast<std::size_t>(info_.channel_count)
+            );
+        });
+    } else {
+        preroll_.reset();
+    }
+
+    clock_.reset();
+    samples_acquired_ = 0;
+    clock_offset_ = 0.0;
+    clock_drift_ppm_ = 0.0;
+    clock_jitter_ = 0.0;
+    clock_updates_ = 0;
+    sample_times_.assign(max_chunk_samples_, 0.0);
+    stats_.reset();
+    stats_.setChunkSamples(chunk_samples_);
+    last_chunk_duration_ = 0.0;
+    pending_.reset();
+    retired_.reset();
+    update_pending_ = false;
+    pacer_ = Pacer({
+        .rate = config_.pace ? info_.sample_rate : 0.0,
+        .spin = config_.pacing_spin
+    });
+
     // Start the streaming thread
-    shutdown_ = false;
     running_ = true;
-    thread_ = std::make_unique<std::thread>(&StreamThread::threadFunction, this);
+    thread_ = std::jthread([this](std::stop_token stop) { threadFunction(std::move(stop)); });
 
     if (statusCallback_) {
         statusCallback_("Streaming started", false);
@@ -49,31 +313,241 @@ bool StreamThread::start() {
 }
 
 void StreamThread::stop() {
-    if (!running_) {
+    // Also reached after the thread ended on its own (device error, end of
+    // a replay): it still has to be joined and the device disconnected
+    if (!thread_.joinable()) {
         return;
     }
 
-    // Signal shutdown
-    shutdown_ = true;
-
     // Wait for thread to finish
-    if (thread_ && thread_->joinable()) {
-        thread_->join();
-    }
-    thread_.reset();
+    const auto requested = std::chrono::steady_clock::now();
+    thread_.request_stop();
+    thread_.join();
+    const auto waited = std::chrono::steady_clock::now() - requested;
 
     // Disconnect device
     if (device_) {
         device_->disconnect();
     }
 
+    // Everything published is queued by now; write it out
+    if (recorder_) {
+        recorder_->stop();
+    }
+
     running_ = false;
+    {
+        std::lock_guard<std::mutex> lock(update_mutex_);
+        pending_.reset();
+        retired_.reset();
+        update_pending_ = false;
+    }
+
+    // What the streaming threads reported comes before the summary
+    status_.flush();
 
     if (statusCallback_) {
+        if (waited > kSlowStop) {
+            statusCallback_(
+                "Streaming threads took " +
+                std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(waited).count()) +
+                " ms to stop; the device did not return from getData() sooner",
+                false
+            );
+        }
+        if (ring_) {
+            const auto stats = ring_->stats();
+            statusCallback_(
+                "Ring high-water " + std::to_string(stats.high_water) + "/" +
+                std::to_string(stats.capacity) + " chunks, " +
+                std::to_string(stats.dropped) + " dropped",
+                false
+            );
+        }
+        if (info_.sample_rate > 0 && pacer_.samples() > 0) {
+            const double achieved = pacer_.achievedRate();
+            statusCallback_(
+                "Achieved rate " + std::to_string(achieved) + " Hz (nominal " +
+                std::to_string(info_.sample_rate) + " Hz, " +
+                std::to_string((achieved / info_.sample_rate - 1.0) * 1e6) + " ppm)",
+                false
+            );
+        }
+        if (recorder_) {
+            const auto stats = recorder_->stats();
+            statusCallback_(
+                "Recorded " + std::to_string(stats.samples) + " samples (" +
+                std::to_string(stats.bytes / 1024) + " KiB, " +
+                std::to_string(stats.segments) + " segments), " +
+                std::to_string(stats.dropped) + " chunks dropped",
+                false
+            );
+        }
+        if (preroll_) {
+            const auto stats = stats_.snapshot();
+            statusCallback_(
+                "Gated " + std::to_string(stats.samples_gated) + " samples without consumers, " +
+                std::to_string(stats.preroll_discarded) + " aged out of the pre-roll",
+                false
+            );
+        }
+        if (config_.adaptive_chunk) {
+            statusCallback_(
+                "Adaptive chunk size " + std::to_string(chunk_samples_) + " samples",
+                false
+            );
+        }
+        if (const auto stats = stats_.snapshot(); rate_monitor_ && stats.delivered_rate > 0.0) {
+            statusCallback_(
+                "Device delivered " + std::to_string(stats.delivered_rate) + " Hz over the last window" +
+                (stats.rate_deviating ? " (off nominal)" : "") + ", " +
+                std::to_string(stats.stalls) + " stalls",
+                false
+            );
+        }
+        if (const auto stats = stats_.snapshot(); stats.reconnects > 0) {
+            statusCallback_(
+                "Device reconnected " + std::to_string(stats.reconnects) + " times, recovery p50 " +
+                std::to_string(stats.recovery.percentile(0.5) * 1000.0) + " ms, max " +
+                std::to_string(stats.recovery.percentile(1.0) * 1000.0) + " ms, ~" +
+                std::to_string(stats.samples_missed) + " samples missed",
+                false
+            );
+        }
+        if (clock_updates_ > 0) {
+            const auto clock = getClockEstimate();
+            statusCallback_(
+                "Clock offset " + std::to_string(clock.offset) + " s, drift " +
+                std::to_string(clock.drift_ppm) + " ppm, jitter " +
+                std::to_string(clock.jitter * 1000.0) + " ms",
+                false
+            );
+        }
         statusCallback_("Streaming stopped", false);
     }
 }
 
+StreamThread::UpdateResult StreamThread::update(const Config& config,
+                                                std::optional<int> device_parameter) {
+    std::unique_lock<std::mutex> lock(update_mutex_);
+    if (!running_) {
+        return UpdateResult::NeedsRestart;
+    }
+
+    // Anything but these fields needs a new outlet or pipeline
+    Config hot = config_;
+    hot.filters = config.filters;
+    hot.chunk_duration = config.chunk_duration;
+    if (hot != config) {
+        return UpdateResult::NeedsRestart;
+    }
+
+    auto next = std::make_unique<PendingUpdate>();
+    std::vector<std::string> changes;
+
+    if (config.chunk_duration != config_.chunk_duration) {
+        // Adaptive mode owns the chunk size; larger chunks outgrow the buffers
+        const std::size_t samples = chunkSamples(info_, config.chunk_duration);
+        if (config_.adaptive_chunk || samples > max_chunk_samples_) {
+            return UpdateResult::NeedsRestart;
+        }
+        next->chunk_samples = samples;
+        changes.push_back("chunk size " + std::to_string(samples) + " samples");
+    }
+
+    if (config.filters != config_.filters) {
+        // Designed here, off the streaming threads
+        next->replace_filters = true;
+        if (!config.filters.empty()) {
+            next->filters = std::make_unique<FilterChain>(
+                config.filters, info_.format, info_.sample_rate,
+                static_cast<std::size_t>(info_.channel_count));
+            if (!next->filters->isValid()) {
+                const std::string error = next->filters->error();
+                lock.unlock();
+                if (statusCallback_) {
+                    statusCallback_("Invalid filters: " + error, true);
+                }
+                return UpdateResult::Invalid;
+            }
+            changes.push_back(std::to_string(next->filters->stages()) + " biquad stages");
+        } else {
+            changes.push_back("no filters");
+        }
+    }
+
+    if (device_parameter) {
+        next->device_parameter = device_parameter;
+        changes.push_back("device parameter " + std::to_string(*device_parameter));
+    }
+
+    if (changes.empty()) {
+        return UpdateResult::Unchanged;
+    }
+
+    // Fold into an update the acquisition thread has not picked up yet
+    if (pending_) {
+        if (!next->replace_filters && pending_->replace_filters) {
+            next->replace_filters = true;
+            next->filters = std::move(pending_->filters);
+        }
+        if (next->chunk_samples == 0) {
+            next->chunk_samples = pending_->chunk_samples;
+        }
+        if (!next->device_parameter) {
+            next->device_parameter = pending_->device_parameter;
+        }
+    }
+    pending_ = std::move(next);
+    retired_.reset();
+    config_.filters = config.filters;
+    config_.chunk_duration = config.chunk_duration;
+    update_pending_.store(true, std::memory_order_release);
+    lock.unlock();
+
+    if (statusCallback_) {
+        std::string message = "Applying";
+        for (std::size_t i = 0; i < changes.size(); ++i) {
+            message += (i == 0 ? " " : ", ") + changes[i];
+        }
+        statusCallback_(message + " at the next chunk", false);
+    }
+    return UpdateResult::Applied;
+}
+
+void StreamThread::applyUpdate() {
+    // Never wait on the acquisition thread: retry at the next chunk instead
+    std::unique_lock<std::mutex> lock(update_mutex_, std::try_to_lock);
+    if (!lock.owns_lock() || !pending_) {
+        return;
+    }
+    auto update = std::move(pending_);
+    update_pending_.store(false, std::memory_order_relaxed);
+
+    if (update->replace_filters) {
+        std::swap(filters_, update->filters);
+    }
+    if (update->chunk_samples > 0) {
+        chunk_samples_ = update->chunk_samples;
+        stats_.setChunkSamples(chunk_samples_);
+        if (rate_monitor_) {
+            rate_monitor_->setChunkPeriod(chunkPeriod(info_, chunk_samples_));
+        }
+    }
+    const bool parameter_failed =
+        update->device_parameter && !device_->setParameter(*update->device_parameter);
+    retired_ = std::move(update);
+    lock.unlock();
+
+    if (parameter_failed) {
+        status_.error("Device cannot change its parameter while streaming; restart to apply it");
+    }
+}
+
+void StreamThread::requestStop() {
+    thread_.request_stop();
+}
+
 bool StreamThread::isRunning() const {
     return running_;
 }
@@ -85,46 +559,518 @@ DeviceInfo StreamThread::getDeviceInfo() const {
     return {};
 }
 
-void StreamThread::threadFunction() {
+RingStats StreamThread::getRingStats() const {
+    return ring_ ? ring_->stats() : RingStats{};
+}
+
+StreamStats StreamThread::getStats() const {
+    return stats_.snapshot();
+}
+
+RecorderStats StreamThread::getRecorderStats() const {
+    return recorder_ ? recorder_->stats() : RecorderStats{};
+}
+
+ClockEstimate StreamThread::getClockEstimate() const {
+    return {
+        .offset = clock_offset_.load(std::memory_order_relaxed),
+        .drift_ppm = clock_drift_ppm_.load(std::memory_order_relaxed),
+        .jitter = clock_jitter_.load(std::memory_order_relaxed),
+        .updates = clock_updates_.load(std::memory_order_relaxed)
+    };
+}
+
+void StreamThread::threadFunction(std::stop_token stop) {
+    stop_ = std::move(stop);
+    device_->setStopToken(stop_);
+    applyThreadScheduling(config_.acquisition_scheduling, "acquisition", status_.callback());
+    if (config_.lock_memory) {
+        prefaultStack();
+    }
+
     try {
         // Create LSL outlet
-        auto info = device_->getInfo();
-        LSLOutlet outlet(info);
+        // A fixed transmit chunk only makes sense when reads are fixed-size
+        LSLOutlet outlet(
+            info_,
+            config_.adaptive_chunk ? 0 : static_cast<int>(chunk_samples_),
+            config_.max_buffered
+        );
 
-        if (statusCallback_) {
-            statusCallback_("LSL outlet created: " + info.name, false);
+        status_.info("LSL outlet created: ", info_.name);
+        createDerivedOutlets();
+        createSplitOutlets();
+        if (rate_monitor_) {
+            rate_monitor_->restart(std::chrono::steady_clock::now());
         }
 
-        // Allocate buffer for acquisition
-        // Buffer size: enough for ~100ms of data, minimum 1 sample
-        size_t samples_per_chunk = std::max(
-            1,
-            static_cast<int>(info.sample_rate * 0.1)
-        );
-        std::vector<float> buffer(samples_per_chunk * info.channel_count);
-
-        // Acquisition loop
-        while (!shutdown_) {
-            if (device_->getData(buffer)) {
-                outlet.pushChunk(buffer);
+        visitSampleFormat(info_.format, [&]<typename T>() {
+            if (ring_) {
+                runDecoupled<T>(outlet, static_cast<ChunkRing<T>&>(*ring_));
             } else {
-                // getData returned false - device error or disconnection
-                if (!shutdown_) {
-                    if (statusCallback_) {
-                        statusCallback_("Device acquisition error", true);
-                    }
-                }
+                runDirect<T>(outlet);
+            }
+        });
+
+    } catch (const std::exception& e) {
+        status_.error("Streaming error: ", e.what());
+    }
+
+    derived_.clear();
+    split_outlets_.clear();
+    running_ = false;
+}
+
+void StreamThread::createDerivedOutlets() {
+    derived_.clear();
+    std::vector<std::size_t> factors = config_.decimation;
+    std::sort(factors.begin(), factors.end());
+    factors.erase(std::unique(factors.begin(), factors.end()), factors.end());
+
+    const double device_interval = 1.0 / info_.sample_rate;
+    for (std::size_t factor : factors) {
+        // Cascade from the largest smaller factor that divides this one
+        auto derived = std::make_unique<DerivedOutlet>();
+        derived->factor = factor;
+        for (std::size_t i = derived_.size(); i-- > 0;) {
+            if (factor % derived_[i]->factor == 0) {
+                derived->parent = i;
                 break;
             }
         }
+        const std::size_t stage = derived->parent == kNoParent
+            ? factor
+            : factor / derived_[derived->parent]->factor;
 
-    } catch (const std::exception& e) {
-        if (statusCallback_) {
-            statusCallback_(std::string("Streaming error: ") + e.what(), true);
+        visitSampleFormat(info_.format, [&]<typename T>() {
+            if constexpr (std::is_floating_point_v<T>) {
+                derived->decimator = std::make_unique<Decimator<T>>(
+                    stage, static_cast<std::size_t>(info_.channel_count));
+            }
+        });
+        const DeviceInfo info = derivedInfo(info_, factor);
+        derived->outlet = std::make_unique<LSLOutlet>(info, 0, config_.max_buffered);
+        derived->sample_interval = device_interval * static_cast<double>(factor);
+
+        const std::string parent = derived->parent == kNoParent
+            ? std::string() : " of " + derivedInfo(info_, derived_[derived->parent]->factor).name;
+        status_.info("LSL outlet created: ", info.name, " (", info.sample_rate, " Hz, ",
+                     derived->decimator->taps(), "-tap decimation by ", stage, parent, ")");
+        derived_.push_back(std::move(derived));
+    }
+}
+
+void StreamThread::createSplitOutlets() {
+    split_outlets_.clear();
+    for (const auto& split : config_.splits) {
+        const DeviceInfo info = splitInfo(info_, split);
+        split_outlets_.push_back(std::make_unique<LSLOutlet>(info, 0, config_.max_buffered));
+        status_.info("LSL outlet created: ", info.name, " (", info.type, ", channels ",
+                     formatChannelList(split.channels), ")");
+    }
+}
+
+template <typename T>
+void StreamThread::runDirect(LSLOutlet& outlet) {
+    // Allocate buffer for acquisition
+    Chunk<T> chunk;
+    chunk.data.resize(max_chunk_samples_ * info_.channel_count);
+
+    // Acquisition loop
+    while (!stop_.stop_requested()) {
+        if (!acquire(chunk)) {
+            break;
         }
+        publish(chunk, outlet);
     }
+}
 
-    running_ = false;
+template <typename T>
+void StreamThread::runDecoupled(LSLOutlet& outlet, ChunkRing<T>& ring) {
+    // Publisher: drain the ring into the outlet until it is closed and empty
+    std::thread publisher([this, &ring, &outlet]() {
+        applyThreadScheduling(config_.publisher_scheduling, "publisher", status_.callback());
+        if (config_.lock_memory) {
+            prefaultStack();
+        }
+
+        try {
+            while (Chunk<T>* chunk = ring.read()) {
+                publish(*chunk, outlet);
+                ring.release();
+            }
+        } catch (const std::exception& e) {
+            status_.error("Publishing error: ", e.what());
+        }
+        // Unblock the producer if publishing failed
+        ring.close();
+    });
+
+    // A producer blocked on a full ring, or an idle publisher, wakes on stop
+    std::stop_callback close_on_stop(stop_, [&ring]() { ring.close(); });
+
+    // Acquisition: fill ring slots; commit() applies the overflow policy
+    while (!stop_.stop_requested() && !ring.isClosed()) {
+        Chunk<T>& slot = ring.writeSlot();
+        if (!acquire(slot)) {
+            break;
+        }
+        if (slot.samples > 0) {
+            ring.commit();
+        }
+    }
+
+    ring.close();
+    publisher.join();
+}
+
+template <typename T>
+bool StreamThread::acquire(Chunk<T>& chunk) {
+    if (update_pending_.load(std::memory_order_acquire)) {
+        applyUpdate();
+    }
+
+    // Work since the previous read outlasting that chunk means falling behind
+    const auto read_start = std::chrono::steady_clock::now();
+    if (last_chunk_duration_ > 0.0 &&
+        std::chrono::duration<double>(read_start - last_read_end_).count() > last_chunk_duration_) {
+        stats_.recordOverrun();
+    }
+
+    double device_timestamp = 0.0;
+    const std::size_t channels = static_cast<std::size_t>(info_.channel_count);
+    const std::size_t samples = device_->getData(
+        std::span<T>(chunk.data).first(chunk_samples_ * channels), device_timestamp);
+
+    last_read_end_ = std::chrono::steady_clock::now();
+    stats_.recordRead(last_read_end_ - read_start);
+
+    if (samples == IDevice::kEndOfData) {
+        status_.info("Device has no more data");
+        return false;
+    }
+    if (samples == IDevice::kReadError) {
+        // Device error or disconnection
+        if (stop_.stop_requested()) {
+            return false;
+        }
+        status_.error("Device acquisition error");
+        if (!config_.reconnect || !reconnectDevice()) {
+            return false;
+        }
+        // The outage is reported as a reconnect, not as a stall
+        if (rate_monitor_) {
+            rate_monitor_->restart(std::chrono::steady_clock::now());
+        }
+        // Nothing to publish this round; the next read starts afresh
+        chunk.samples = 0;
+        chunk.timestamp = 0.0;
+        chunk.sample_interval = 0.0;
+        last_chunk_duration_ = 0.0;
+        return true;
+    }
+
+    chunk.samples = std::min(samples, chunk_samples_);
+    if (chunk.samples > 0) {
+        stats_.recordData(last_read_end_);
+    }
+    if (rate_monitor_) {
+        monitorRate(chunk.samples, last_read_end_);  // Empty reads too, to catch stalls early
+    }
+    if constexpr (std::is_floating_point_v<T>) {
+        if (filters_) {
+            filters_->process(chunk.data.data(), chunk.samples);
+        }
+    }
+    last_chunk_duration_ = info_.sample_rate > 0
+        ? static_cast<double>(chunk.samples) / info_.sample_rate
+        : 0.0;
+    pacer_.wait(chunk.samples, stop_);
+    if (config_.pace) {
+        last_read_end_ = std::chrono::steady_clock::now();  // Waiting is not work
+    }
+    chunk.timestamp = device_timestamp;
+    chunk.sample_interval = 0.0;
+    if (chunk.samples > 0) {
+        stampChunk(chunk.samples, device_timestamp, chunk.timestamp, chunk.sample_interval);
+    }
+
+    if (config_.adaptive_chunk) {
+        samples_since_adapt_ += chunk.samples;
+        if (static_cast<double>(samples_since_adapt_) >= info_.sample_rate * kAdaptInterval) {
+            samples_since_adapt_ = 0;
+            adaptChunkSize();
+        }
+    }
+    return true;
+}
+
+void StreamThread::monitorRate(std::size_t samples, std::chrono::steady_clock::time_point now) {
+    const RateMonitor& monitor = *rate_monitor_;
+    switch (rate_monitor_->onRead(samples, now)) {
+        case RateMonitor::Event::Stall:
+            stats_.recordStall();
+            status_.error("Device stalled: no data for ", std::llround(monitor.lastGap() * 1000.0),
+                          " ms (expected every ", std::llround(monitor.chunkPeriod() * 1000.0), " ms)");
+            break;
+        case RateMonitor::Event::Resumed:
+            status_.info("Device resumed after ", std::llround(monitor.lastGap() * 1000.0), " ms");
+            break;
+        case RateMonitor::Event::RateDeviation:
+            status_.error("Device delivers ", std::round(monitor.rate() * 10.0) / 10.0, " Hz, ",
+                          std::round((monitor.rate() / info_.sample_rate - 1.0) * 1000.0) / 10.0,
+                          "% off the nominal ", info_.sample_rate, " Hz");
+            break;
+        case RateMonitor::Event::RateRecovered:
+            status_.info("Device rate back to ", std::round(monitor.rate() * 10.0) / 10.0, " Hz");
+            break;
+        case RateMonitor::Event::None:
+            break;
+    }
+    stats_.recordRate(monitor.rate(), monitor.deviating());
+}
+
+bool StreamThread::reconnectDevice() {
+    using Clock = std::chrono::steady_clock;
+    const auto failed = Clock::now();
+    const auto timeout = std::chrono::duration<double>(config_.reconnect_timeout);
+    auto delay = std::chrono::duration<double>(config_.reconnect_delay);
+
+    device_->disconnect();
+    for (unsigned attempt = 1;; ++attempt) {
+        if (!sleepUntil(Clock::now() + std::chrono::duration_cast<Clock::duration>(delay), stop_)) {
+            return false;
+        }
+
+        if (device_->connect()) {
+            const DeviceInfo info = device_->getInfo();
+            if (info.channel_count != info_.channel_count || info.format != info_.format ||
+                info.sample_rate != info_.sample_rate) {
+                status_.error("Device reconnected with a different channel count, format or rate");
+                return false;
+            }
+
+            const auto recovery = Clock::now() - failed;
+            const double seconds = std::chrono::duration<double>(recovery).count();
+            const auto missed = static_cast<uint64_t>(std::llround(seconds * info_.sample_rate));
+            stats_.recordReconnect(recovery, missed);
+
+            // Keep the sample-count clock continuous across the gap; a
+            // hardware clock may have restarted, so refit that one
+            samples_acquired_ += missed;
+            if (info_.timestamp_clock == TimestampClock::Device) {
+                clock_.reset();
+            }
+            status_.info("Device reconnected after ", attempt, attempt == 1 ? " attempt" : " attempts",
+                         " in ", std::llround(seconds * 1000.0), " ms, ~", missed, " samples missed");
+            return true;
+        }
+
+        if (timeout.count() > 0 && Clock::now() - failed >= timeout) {
+            status_.error("Device did not reconnect within ", config_.reconnect_timeout, " s");
+            return false;
+        }
+        delay = std::min(delay * 2.0, std::chrono::duration<double>(config_.reconnect_max_delay));
+    }
+}
+
+void StreamThread::adaptChunkSize() {
+    const double srate = info_.sample_rate;
+    if (srate <= 0) {
+        return;  // Irregular streams read one sample at a time
+    }
+
+    // Shortest chunk whose push overhead fits the CPU budget
+    const double cost = push_cost_.load(std::memory_order_relaxed);
+    const double min_duration = config_.cpu_budget > 0 ? cost / config_.cpu_budget : 0.0;
+    const double desired = std::max(config_.latency_target, min_duration);
+
+    const std::size_t current = chunk_samples_;
+    std::size_t target = std::clamp<std::size_t>(
+        static_cast<std::size_t>(std::ceil(desired * srate)), 1, max_chunk_samples_);
+    target = std::clamp<std::size_t>(target, std::max<std::size_t>(1, current / 2),
+                                     std::min(max_chunk_samples_, current * 2));
+
+    const double change = std::abs(static_cast<double>(target) - static_cast<double>(current));
+    if (change > static_cast<double>(current) * kAdaptDeadBand) {
+        chunk_samples_ = target;
+        stats_.setChunkSamples(target);
+        if (rate_monitor_) {
+            rate_monitor_->setChunkPeriod(chunkPeriod(info_, target));
+        }
+    }
+}
+
+void StreamThread::stampChunk(
+    std::size_t samples,
+    double device_timestamp,
+    double& timestamp,
+    double& sample_interval
+) {
+    const bool device_clock = info_.timestamp_clock == TimestampClock::Device;
+    const double srate = info_.sample_rate;
+    samples_acquired_ += samples;
+
+    if (!config_.dejitter && !device_clock) {
+        return;  // LSL-clock timestamp (or 0.0) is pushed as-is
+    }
+
+    // Regress observed LSL time on device time. Device time is the hardware
+    // timestamp if there is one, else the sample count at the nominal rate.
+    double device_time;
+    if (device_clock && device_timestamp != 0.0) {
+        device_time = device_timestamp;
+    } else if (srate > 0) {
+        device_time = static_cast<double>(samples_acquired_ - 1) / srate;
+    } else {
+        timestamp = 0.0;  // Irregular stream without timestamps: stamp at push
+        return;
+    }
+    const double observed = (!device_clock && device_timestamp != 0.0)
+        ? device_timestamp
+        : lsl::local_clock();
+
+    clock_.update(device_time, observed);
+    timestamp = clock_.map(device_time);
+    sample_interval = srate > 0 ? clock_.slope() / srate : 0.0;
+
+    const auto estimate = clock_.estimate();
+    clock_offset_.store(estimate.offset, std::memory_order_relaxed);
+    clock_drift_ppm_.store(estimate.drift_ppm, std::memory_order_relaxed);
+    clock_jitter_.store(estimate.jitter, std::memory_order_relaxed);
+    clock_updates_.store(estimate.updates, std::memory_order_relaxed);
+}
+
+template <typename T>
+void StreamThread::publish(const Chunk<T>& chunk, LSLOutlet& outlet) {
+    const bool consumers = outlet.hasConsumers();
+    stats_.recordConsumers(consumers);
+
+    // The local preview shows the signal whether or not anyone subscribed
+    if (preview_ && chunk.samples > 0) {
+        preview_->write(chunk.data.data(), chunk.samples);
+    }
+
+    // Chunks kept beyond this call need the timestamps liblsl would assign,
+    // and the outlet then gets the same ones
+    double timestamp = chunk.timestamp;
+    double interval = chunk.sample_interval;
+    if ((recorder_ || preroll_ || !derived_.empty() || splitter_) && chunk.samples > 0) {
+        if (timestamp == 0.0) {
+            timestamp = lsl::local_clock();
+        }
+        if (interval <= 0.0 && info_.sample_rate > 0) {
+            interval = 1.0 / info_.sample_rate;
+        }
+        if (recorder_) {
+            recorder_->record(chunk.data.data(), chunk.samples, timestamp, interval);
+        }
+
+        // Derived and split outlets have consumers of their own: not gated
+        if (!derived_.empty() || splitter_) {
+            for (std::size_t i = 0; i < chunk.samples; ++i) {
+                input_times_[i] = timestamp - static_cast<double>(chunk.samples - 1 - i) * interval;
+            }
+            publishDerived(chunk, interval);
+            publishSplits(chunk);
+        }
+    }
+
+    if (preroll_) {
+        auto& preroll = static_cast<PrerollBuffer<T>&>(*preroll_);
+        if (!consumers) {
+            // Nobody listening: hold the samples instead of pushing them
+            if (chunk.samples > 0) {
+                const std::size_t discarded =
+                    preroll.append(chunk.data.data(), chunk.samples, timestamp, interval);
+                stats_.recordGated(chunk.samples, discarded);
+            }
+            return;
+        }
+        if (!preroll.empty()) {
+            flushPreroll(preroll, outlet);
+        }
+    }
+
+    const std::size_t elements = chunk.samples * static_cast<std::size_t>(info_.channel_count);
+    const auto push_start = std::chrono::steady_clock::now();
+
+    if (chunk.sample_interval > 0.0) {
+        // Exact per-sample timestamps from the clock model
+        for (std::size_t i = 0; i < chunk.samples; ++i) {
+            sample_times_[i] = chunk.timestamp -
+                static_cast<double>(chunk.samples - 1 - i) * chunk.sample_interval;
+        }
+        outlet.pushChunk(chunk.data.data(), sample_times_.data(), elements);
+    } else {
+        outlet.pushChunk(chunk.data.data(), elements, timestamp);
+    }
+
+    const auto push_end = std::chrono::steady_clock::now();
+    stats_.recordPush(chunk.samples, payloadBytes(chunk.data.data(), elements), push_end - push_start);
+
+    const double cost = std::chrono::duration<double>(push_end - push_start).count();
+    const double previous = push_cost_.load(std::memory_order_relaxed);
+    push_cost_.store(previous + kPushCostSmoothing * (cost - previous), std::memory_order_relaxed);
+}
+
+template <typename T>
+void StreamThread::publishDerived(const Chunk<T>& chunk, double sample_interval) {
+    if constexpr (std::is_floating_point_v<T>) {
+        const std::size_t channels = static_cast<std::size_t>(info_.channel_count);
+
+        // Parents precede their children, so each input is already decimated
+        for (auto& derived : derived_) {
+            const T* input = chunk.data.data();
+            std::size_t samples = chunk.samples;
+            const double* times = input_times_.data();
+            double interval = sample_interval;
+            if (derived->parent != kNoParent) {
+                const DerivedOutlet& parent = *derived_[derived->parent];
+                input = static_cast<const Decimator<T>&>(*parent.decimator).output();
+                samples = parent.decimator->outputs();
+                times = parent.times.data();
+                interval = parent.sample_interval;
+            }
+
+            auto& decimator = static_cast<Decimator<T>&>(*derived->decimator);
+            const std::size_t outputs = decimator.process(input, samples);
+            derived->times.resize(outputs);
+            const double delay = decimator.delay() * interval;
+            for (std::size_t m = 0; m < outputs; ++m) {
+                derived->times[m] = times[decimator.positions()[m]] - delay;
+            }
+            derived->outlet->pushChunk(decimator.output(), derived->times.data(), outputs * channels);
+        }
+    }
+}
+
+template <typename T>
+void StreamThread::publishSplits(const Chunk<T>& chunk) {
+    if (!splitter_) {
+        return;
+    }
+    auto& splitter = static_cast<ChannelSplitter<T>&>(*splitter_);
+    splitter.split(chunk.data.data(), chunk.samples);
+    for (std::size_t i = 0; i < split_outlets_.size(); ++i) {
+        split_outlets_[i]->pushChunk(splitter.output(i), input_times_.data(),
+                                     chunk.samples * splitter.channels(i));
+    }
+}
+
+template <typename T>
+void StreamThread::flushPreroll(PrerollBuffer<T>& preroll, LSLOutlet& outlet) {
+    // Not folded into push_cost_: a one-off burst says nothing about chunk size
+    const std::size_t held = preroll.size();
+    const std::size_t channels = static_cast<std::size_t>(info_.channel_count);
+    preroll.drain([&](const T* data, const double* timestamps, std::size_t samples) {
+        const auto push_start = std::chrono::steady_clock::now();
+        outlet.pushChunk(data, timestamps, samples * channels);
+        stats_.recordPush(samples, payloadBytes(data, samples * channels),
+                          std::chrono::steady_clock::now() - push_start);
+    });
+
+    status_.info("Consumer connected, flushed ", held, " pre-roll samples");
 }
 
 } // namespace lsltemplate
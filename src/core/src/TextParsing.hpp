@@ -0,0 +1,66 @@
+#pragma once
+/**
+ * @file TextParsing.hpp
+ * @brief Whitespace trimming and number parsing shared by the text formats (private)
+ *
+ * Config files, filter and signal lists, channel layouts, channel splits and
+ * CSV replays all parse the same way, so a value that is valid in one place
+ * is valid in every other.
+ */
+
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <optional>
+#include <string_view>
+
+namespace lsltemplate {
+
+/// `text` without leading and trailing whitespace
+inline std::string_view trim(std::string_view text) {
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front()))) {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back()))) {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+/**
+ * @brief Parse a whole field as a number, ignoring surrounding whitespace
+ *
+ * Accepts what strtod() accepts, including "nan" and "inf": recordings mark
+ * missing samples with NaN; parseFiniteNumber() rejects them.
+ * Runs without allocating, as CSV replays call it once per value.
+ *
+ * @return The value, or nullopt if the field is empty, longer than 63
+ *         characters or not a number throughout
+ */
+inline std::optional<double> parseNumber(std::string_view text) {
+    char buffer[64];
+    text = trim(text);
+    if (text.empty() || text.size() >= sizeof(buffer)) {
+        return std::nullopt;
+    }
+    std::memcpy(buffer, text.data(), text.size());
+    buffer[text.size()] = '\0';
+    char* end = nullptr;
+    const double value = std::strtod(buffer, &end);
+    if (end != buffer + text.size()) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+/// parseNumber() for settings, where NaN and infinities are mistakes
+inline std::optional<double> parseFiniteNumber(std::string_view text) {
+    const auto value = parseNumber(text);
+    if (!value || !std::isfinite(*value)) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+} // namespace lsltemplate
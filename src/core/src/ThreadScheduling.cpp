@@ -0,0 +1,251 @@
+#include "lsltemplate/ThreadScheduling.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <set>
+#include <sstream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+#endif
+
+namespace lsltemplate {
+
+namespace {
+
+constexpr std::size_t kStackPrefaultBytes = std::size_t{256} << 10;
+
+void report(const StatusCallback& callback, const std::string& message) {
+    if (callback) {
+        callback(message, true);
+    }
+}
+
+std::string toLower(std::string value) {
+    std::transform(value.begin(), value.end(), value.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return value;
+}
+
+#ifdef _WIN32
+std::string lastError() {
+    return "error " + std::to_string(GetLastError());
+}
+#else
+std::string errorText(int error) {
+    return std::strerror(error);
+}
+#endif
+
+bool applyPolicy(const ThreadScheduling& scheduling, const std::string& thread_name,
+                 const StatusCallback& callback) {
+    if (scheduling.policy == SchedulingPolicy::Default) {
+        return true;
+    }
+
+#ifdef _WIN32
+    // No real-time policies; the highest priority within the process class
+    if (!SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL)) {
+        report(callback, "Cannot raise priority of the " + thread_name + " thread: " + lastError());
+        return false;
+    }
+    return true;
+#else
+    const int policy = scheduling.policy == SchedulingPolicy::Fifo ? SCHED_FIFO : SCHED_RR;
+    sched_param param{};
+    param.sched_priority = std::clamp(scheduling.priority,
+                                      sched_get_priority_min(policy),
+                                      sched_get_priority_max(policy));
+    const int result = pthread_setschedparam(pthread_self(), policy, &param);
+    if (result != 0) {
+        report(callback, std::string("Cannot set ") + toString(scheduling.policy) +
+               " priority " + std::to_string(param.sched_priority) + " for the " +
+               thread_name + " thread: " + errorText(result) +
+               (result == EPERM ? " (needs CAP_SYS_NICE or an rtprio limit)" : ""));
+        return false;
+    }
+    return true;
+#endif
+}
+
+bool applyAffinity(const ThreadScheduling& scheduling, const std::string& thread_name,
+                   const StatusCallback& callback) {
+    if (scheduling.cpus.empty()) {
+        return true;
+    }
+    const std::string cpus = formatCpuList(scheduling.cpus);
+
+#if defined(_WIN32)
+    DWORD_PTR mask = 0;
+    for (int cpu : scheduling.cpus) {
+        if (cpu < static_cast<int>(sizeof(mask) * 8)) {
+            mask |= DWORD_PTR{1} << cpu;
+        }
+    }
+    if (mask == 0 || !SetThreadAffinityMask(GetCurrentThread(), mask)) {
+        report(callback, "Cannot pin the " + thread_name + " thread to CPUs " + cpus + ": " + lastError());
+        return false;
+    }
+    return true;
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : scheduling.cpus) {
+        if (cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &set);
+        }
+    }
+    const int result = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    if (result != 0) {
+        report(callback, "Cannot pin the " + thread_name + " thread to CPUs " + cpus + ": " +
+               errorText(result));
+        return false;
+    }
+    return true;
+#else
+    report(callback, "CPU affinity is not supported on this platform; the " + thread_name +
+           " thread is not pinned to CPUs " + cpus);
+    return false;
+#endif
+}
+
+} // anonymous namespace
+
+std::optional<SchedulingPolicy> parseSchedulingPolicy(const std::string& name) {
+    const std::string lower = toLower(name);
+    if (lower == "default" || lower == "other" || lower == "none" || lower.empty()) {
+        return SchedulingPolicy::Default;
+    }
+    if (lower == "fifo") {
+        return SchedulingPolicy::Fifo;
+    }
+    if (lower == "rr" || lower == "round-robin") {
+        return SchedulingPolicy::RoundRobin;
+    }
+    return std::nullopt;
+}
+
+const char* toString(SchedulingPolicy policy) {
+    switch (policy) {
+        case SchedulingPolicy::Fifo: return "fifo";
+        case SchedulingPolicy::RoundRobin: return "rr";
+        case SchedulingPolicy::Default: break;
+    }
+    return "default";
+}
+
+std::optional<std::vector<int>> parseCpuList(const std::string& list) {
+    std::set<int> cpus;
+    std::istringstream input(list);
+    std::string item;
+    while (std::getline(input, item, ',')) {
+        item.erase(std::remove_if(item.begin(), item.end(),
+                                  [](unsigned char c) { return std::isspace(c); }),
+                   item.end());
+        if (item.empty()) {
+            continue;
+        }
+        const auto dash = item.find('-');
+        const std::string first = item.substr(0, dash);
+        const std::string last = dash == std::string::npos ? first : item.substr(dash + 1);
+        auto digits = [](const std::string& s) {
+            return !s.empty() && std::all_of(s.begin(), s.end(),
+                [](unsigned char c) { return std::isdigit(c); });
+        };
+        if (!digits(first) || !digits(last) || first.size() > 4 || last.size() > 4) {
+            return std::nullopt;
+        }
+        const int begin = std::stoi(first);
+        const int end = std::stoi(last);
+        if (end < begin) {
+            return std::nullopt;
+        }
+        for (int cpu = begin; cpu <= end; ++cpu) {
+            cpus.insert(cpu);
+        }
+    }
+    return std::vector<int>(cpus.begin(), cpus.end());
+}
+
+std::string formatCpuList(const std::vector<int>& cpus) {
+    std::vector<int> sorted(cpus);
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+    std::string out;
+    for (std::size_t i = 0; i < sorted.size();) {
+        std::size_t j = i;
+        while (j + 1 < sorted.size() && sorted[j + 1] == sorted[j] + 1) {
+            ++j;
+        }
+        if (!out.empty()) {
+            out += ',';
+        }
+        out += std::to_string(sorted[i]);
+        if (j > i) {
+            out += '-' + std::to_string(sorted[j]);
+        }
+        i = j + 1;
+    }
+    return out;
+}
+
+bool applyThreadScheduling(const ThreadScheduling& scheduling, const std::string& thread_name,
+                           const StatusCallback& callback) {
+    // Pin first: a real-time thread should not start out on a busy CPU
+    const bool pinned = applyAffinity(scheduling, thread_name, callback);
+    const bool prioritized = applyPolicy(scheduling, thread_name, callback);
+    return pinned && prioritized;
+}
+
+bool lockMemory(const StatusCallback& callback) {
+#ifdef _WIN32
+    report(callback, "Memory locking is not supported on this platform");
+    return false;
+#else
+    // Current pages are faulted in and locked now. Later mappings are locked
+    // page by page as they are touched instead of populated whole, so a
+    // file mapping (MappedFile unlocks those) is not read into RAM up front.
+#ifdef MCL_ONFAULT
+    constexpr int kFuture = MCL_FUTURE | MCL_ONFAULT;
+#else
+    constexpr int kFuture = MCL_FUTURE;
+#endif
+    if (mlockall(MCL_CURRENT) != 0 || mlockall(kFuture) != 0) {
+        const int error = errno;
+        report(callback, "Cannot lock memory: " + errorText(error) +
+               ((error == EPERM || error == ENOMEM)
+                    ? " (needs CAP_IPC_LOCK or a larger memlock limit)" : ""));
+        return false;
+    }
+#ifdef __GLIBC__
+    // Keep freed memory, and serve large blocks from the (locked) heap
+    // instead of fresh mappings; pointless unless the lock took
+    mallopt(M_TRIM_THRESHOLD, -1);
+    mallopt(M_MMAP_MAX, 0);
+#endif
+    return true;
+#endif
+}
+
+void prefaultStack() {
+    volatile unsigned char stack[kStackPrefaultBytes];
+    for (std::size_t i = 0; i < kStackPrefaultBytes; i += 1024) {
+        stack[i] = 0;
+    }
+    static_cast<void>(stack[0]);  // Volatile read: the writes are not optimized out
+}
+
+} // namespace lsltemplate
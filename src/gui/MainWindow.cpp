@@ -4,25 +4,40 @@
  */
 
 #include "MainWindow.hpp"
+#include "PreviewWidget.hpp"
 #include "ui_MainWindow.h"
 
 #include <lsltemplate/Config.hpp>
+#include <lsltemplate/ConfigWatcher.hpp>
 #include <lsltemplate/Device.hpp>
 #include <lsltemplate/StreamThread.hpp>
 
+#include <algorithm>
+#include <filesystem>
+#include <optional>
+
 #include <QCloseEvent>
 #include <QCoreApplication>
 #include <QDir>
 #include <QFileDialog>
 #include <QFileInfo>
+#include <QLabel>
 #include <QMessageBox>
 #include <QStandardPaths>
+#include <QTimer>
 
 #include <lsl_cpp.h>
 
+namespace {
+
+constexpr std::size_t kPreviewColumns = 1024;  // Envelope columns kept for the plot
+
+} // anonymous namespace
+
 MainWindow::MainWindow(const QString& config_file, QWidget* parent)
     : QMainWindow(parent)
     , ui_(std::make_unique<Ui::MainWindow>())
+    , controller_(std::make_unique<StreamController>())
 {
     ui_->setupUi(this);
 
@@ -32,6 +47,19 @@ MainWindow::MainWindow(const QString& config_file, QWidget* parent)
     connect(ui_->actionSave_Configuration, &QAction::triggered, this, &MainWindow::onSaveConfig);
     connect(ui_->actionQuit, &QAction::triggered, this, &QMainWindow::close);
     connect(ui_->actionAbout, &QAction::triggered, this, &MainWindow::onAbout);
+    connect(controller_.get(), &StreamController::started, this, &MainWindow::onStreamStarted);
+    connect(controller_.get(), &StreamController::stopped, this, &MainWindow::onStreamStopped);
+
+    // The plot takes the space between the settings and the Link button
+    preview_ = new PreviewWidget(this);
+    ui_->verticalLayout->insertWidget(1, preview_, 1);
+
+    // Statistics are lock-free snapshots, so polling never disturbs acquisition
+    stats_label_ = new QLabel(this);
+    ui_->statusbar->addPermanentWidget(stats_label_);
+    stats_timer_ = new QTimer(this);
+    stats_timer_->setInterval(1000);
+    connect(stats_timer_, &QTimer::timeout, this, &MainWindow::onStatsTimer);
 
     // Load configuration
     QString cfg_path = config_file.isEmpty() ? findDefaultConfigFile() : config_file;
@@ -41,14 +69,20 @@ MainWindow::MainWindow(const QString& config_file, QWidget* parent)
 }
 
 MainWindow::~MainWindow() {
-    // Stop streaming if running
-    if (stream_) {
-        stream_->stop();
-    }
+    // No reloads while tearing down
+    watcher_.reset();
+
+    // Stop streaming if running; status reports still reach this window
+    controller_.reset();
 }
 
 void MainWindow::closeEvent(QCloseEvent* event) {
-    if (stream_ && stream_->isRunning()) {
+    if (state_ == LinkState::Unlinked) {
+        event->accept();
+        return;
+    }
+
+    if (!close_pending_) {
         auto result = QMessageBox::question(
             this,
             "Streaming Active",
@@ -61,47 +95,224 @@ void MainWindow::closeEvent(QCloseEvent* event) {
             return;
         }
 
-        stream_->stop();
+        // The window closes once the stream is down (see onStreamStopped())
+        close_pending_ = true;
+        if (state_ == LinkState::Linked) {
+            stopStreaming();
+        }
     }
 
-    event->accept();
+    event->ignore();
 }
 
 void MainWindow::onLinkButtonClicked() {
-    if (stream_ && stream_->isRunning()) {
-        // Stop streaming
-        stream_->stop();
-        stream_.reset();
-        setStreaming(false);
-    } else {
-        // Start streaming
-        lsltemplate::MockDevice::Config device_config{
-            .name = ui_->input_name->text().toStdString(),
-            .type = ui_->input_type->text().toStdString(),
-            .channel_count = ui_->input_channels->value(),
-            .sample_rate = ui_->input_srate->value(),
-            .start_value = ui_->input_device->value()
-        };
-
-        auto device = std::make_unique<lsltemplate::MockDevice>(device_config);
-
-        // Create status callback that updates UI (must be thread-safe)
-        auto callback = [this](const std::string& message, bool is_error) {
-            // Use Qt's thread-safe signal mechanism
-            QMetaObject::invokeMethod(this, [this, message, is_error]() {
-                updateStatus(QString::fromStdString(message), is_error);
-            });
-        };
-
-        stream_ = std::make_unique<lsltemplate::StreamThread>(std::move(device), callback);
-
-        if (stream_->start()) {
-            setStreaming(true);
+    switch (state_) {
+        case LinkState::Unlinked:
+            startStreaming();
+            break;
+        case LinkState::Linked:
+            stopStreaming();
+            break;
+        case LinkState::Linking:
+        case LinkState::Unlinking:
+            break;  // The button is disabled
+    }
+}
+
+void MainWindow::startStreaming() {
+    // Synthetic signal settings come from the config file
+    const lsltemplate::AppConfig config = currentConfig();
+    auto signals = config.waveform.empty()
+        ? std::nullopt
+        : lsltemplate::parseChannelSignals(
+            config.waveform, config.amplitude, config.frequency,
+            config.phase, config.chirp_end);
+    if (!config.waveform.empty() && !signals) {
+        updateStatus("Invalid synthetic signal settings; using counter", true);
+    }
+
+    lsltemplate::MockDevice::Config device_config{
+        .name = config.stream_name,
+        .type = config.stream_type,
+        .channel_count = config.channel_count,
+        .sample_rate = config.sample_rate,
+        .start_value = config.device_param,
+        .format = config.sample_format,
+        .device_clock = config.device_clock,
+        .clock_drift_ppm = config.clock_drift_ppm,
+        .signals = signals.value_or(std::vector<lsltemplate::ChannelSignal>{}),
+        .chirp_period = config.chirp_period,
+        .seed = config.seed,
+        .pacing_spin = std::chrono::microseconds(config.pacing_spin_us)
+    };
+
+    auto device = std::make_unique<lsltemplate::MockDevice>(device_config);
+
+    // Create status callback that updates UI (must be thread-safe)
+    auto callback = [this](const std::string& message, bool is_error) {
+        // Use Qt's thread-safe signal mechanism
+        QMetaObject::invokeMethod(this, [this, message, is_error]() {
+            updateStatus(QString::fromStdString(message), is_error);
+        });
+    };
+
+    // Connecting and creating the outlets happen on the controller's thread
+    streamed_config_ = config;
+    setState(LinkState::Linking);
+    controller_->start(std::make_unique<lsltemplate::StreamThread>(
+        std::move(device), streamConfig(config), callback));
+}
+
+void MainWindow::stopStreaming() {
+    setState(LinkState::Unlinking);
+    controller_->stop();
+}
+
+void MainWindow::onStreamStarted(bool ok) {
+    setState(ok ? LinkState::Linked : LinkState::Unlinked);
+
+    if (close_pending_) {
+        if (ok) {
+            stopStreaming();
+        } else {
+            close();
+        }
+        return;
+    }
+    if (!ok) {
+        QMessageBox::warning(this, "Error", "Failed to start streaming");
+    }
+    if (reload_pending_) {
+        reload_pending_ = false;
+        onConfigFileChanged();
+    }
+}
+
+void MainWindow::onStreamStopped() {
+    setState(LinkState::Unlinked);
+
+    if (close_pending_) {
+        close();
+        return;
+    }
+    if (restart_pending_) {
+        restart_pending_ = false;
+        startStreaming();
+        return;
+    }
+    if (reload_pending_) {
+        reload_pending_ = false;
+        onConfigFileChanged();
+    }
+}
+
+lsltemplate::StreamThread::Config MainWindow::streamConfig(const lsltemplate::AppConfig& config) {
+    auto filters = lsltemplate::parseFilters(config.filters);
+    if (!filters) {
+        updateStatus("Invalid filters; streaming unfiltered", true);
+    }
+    auto decimation = lsltemplate::parseDecimation(config.decimate);
+    if (!decimation) {
+        updateStatus("Invalid decimation factors; publishing the raw stream only", true);
+    }
+    std::vector<lsltemplate::ChannelDescription> channel_layout;
+    if (!config.channel_layout.empty()) {
+        const lsltemplate::ChannelLayout layout(config.channel_layout);
+        if (layout.isValid()) {
+            channel_layout = layout.channels();
         } else {
-            stream_.reset();
-            QMessageBox::warning(this, "Error", "Failed to start streaming");
+            updateStatus(QString("Invalid channel layout (%1); using default labels")
+                             .arg(QString::fromStdString(layout.error())), true);
+        }
+    }
+
+    return {
+        .chunk_duration = config.chunk_duration,
+        .max_buffered = config.max_buffered,
+        .adaptive_chunk = config.adaptive_chunk,
+        .latency_target = config.latency_target,
+        .cpu_budget = config.cpu_budget,
+        .decoupled = config.decoupled,
+        .ring_capacity = static_cast<size_t>(config.ring_capacity),
+        .overflow_policy = config.overflow_policy,
+        .dejitter = config.dejitter,
+        .pace = config.pace,
+        .pacing_spin = std::chrono::microseconds(config.pacing_spin_us),
+        .reconnect = config.reconnect,
+        .reconnect_delay = config.reconnect_delay,
+        .reconnect_max_delay = config.reconnect_max_delay,
+        .reconnect_timeout = config.reconnect_timeout,
+        .rate_monitor = {
+            .window = config.rate_window,
+            .tolerance = config.rate_tolerance,
+            .stall_factor = config.stall_factor
+        },
+        .gate_on_consumers = config.gate_on_consumers,
+        .preroll = config.preroll,
+        .filters = filters.value_or(std::vector<lsltemplate::FilterSpec>{}),
+        .decimation = decimation.value_or(std::vector<std::size_t>{}),
+        .channel_layout = channel_layout,
+        .splits = config.splits,
+        .recording = {
+            .path = config.record,
+            .segment_bytes = static_cast<size_t>(std::max(1, config.record_segment_mb)) << 20
+        },
+        .preview = {.columns = kPreviewColumns},
+        .acquisition_scheduling = config.acquisition_scheduling,
+        .publisher_scheduling = config.publisher_scheduling,
+        .lock_memory = config.lock_memory
+    };
+}
+
+void MainWindow::onConfigFileChanged() {
+    if (state_ == LinkState::Linking || state_ == LinkState::Unlinking) {
+        reload_pending_ = true;  // Looked at again once the transition is done
+        return;
+    }
+    std::string error;
+    auto config = lsltemplate::ConfigManager::load(last_config_path_.toStdString(), &error);
+    if (!config) {
+        updateStatus(QString("Failed to reload %1 (%2); keeping the current settings")
+                         .arg(last_config_path_, QString::fromStdString(error)), true);
+        return;
+    }
+    lsltemplate::StreamThread* stream = controller_->stream();
+    if (!stream || !stream->isRunning()) {
+        applyConfig(*config);
+        updateStatus("Reloaded: " + last_config_path_, false);
+        return;
+    }
+    if (*config == streamed_config_) {
+        return;
+    }
+
+    // Settings that leave the stream as it is change in place
+    auto shape = *config;
+    shape.filters = streamed_config_.filters;
+    shape.chunk_duration = streamed_config_.chunk_duration;
+    shape.device_param = streamed_config_.device_param;
+    shape.stats_interval = streamed_config_.stats_interval;
+    if (shape == streamed_config_) {
+        const auto device_param = config->device_param != streamed_config_.device_param
+            ? std::optional<int>(config->device_param) : std::nullopt;
+        switch (stream->update(streamConfig(*config), device_param)) {
+            case lsltemplate::StreamThread::UpdateResult::Applied:
+            case lsltemplate::StreamThread::UpdateResult::Unchanged:
+                applyConfig(*config);
+                streamed_config_ = *config;
+                return;
+            case lsltemplate::StreamThread::UpdateResult::Invalid:
+                return;
+            case lsltemplate::StreamThread::UpdateResult::NeedsRestart:
+                break;
         }
     }
+
+    // Everything else needs a new outlet
+    updateStatus("Configuration changed; recreating the outlet", false);
+    applyConfig(*config);
+    restart_pending_ = true;  // See onStreamStopped()
+    stopStreaming();
 }
 
 void MainWindow::onLoadConfig() {
@@ -144,37 +355,74 @@ void MainWindow::onAbout() {
     QMessageBox::about(this, "About LSL Template", info);
 }
 
+void MainWindow::onStatsTimer() {
+    const lsltemplate::StreamThread* stream = controller_->stream();
+    if (!stream || !stream->isRunning()) {
+        return;
+    }
+
+    const auto stats = stream->getStats();
+    const double interval = stats.elapsed - last_stats_.elapsed;
+    const double rate = interval > 0.0
+        ? static_cast<double>(stats.samples_pushed - last_stats_.samples_pushed) / interval
+        : 0.0;
+    last_stats_ = stats;
+
+    QString text = QString("%1 Hz | push p99 %2 ms | %3 overruns | %4")
+        .arg(rate, 0, 'f', 1)
+        .arg(stats.push_chunk.percentile(0.99) * 1000.0, 0, 'f', 3)
+        .arg(stats.overruns)
+        .arg(stats.has_consumers ? "consumers" : "no consumers");
+    if (stats.rate_deviating) {
+        text += QString(" | device at %1 Hz").arg(stats.delivered_rate, 0, 'f', 1);
+    }
+    if (stats.stalls > 0) {
+        text += QString(" | %1 stalls").arg(stats.stalls);
+    }
+    if (stats.since_data > 1.0) {
+        text += QString(" | no data for %1 s").arg(stats.since_data, 0, 'f', 0);
+    }
+    if (stats.reconnects > 0) {
+        text += QString(" | %1 reconnects (max %2 ms)")
+            .arg(stats.reconnects)
+            .arg(stats.recovery.percentile(1.0) * 1000.0, 0, 'f', 0);
+    }
+    stats_label_->setText(text);
+}
+
 void MainWindow::loadConfig(const QString& filename) {
-    auto config = lsltemplate::ConfigManager::load(filename.toStdString());
+    std::string error;
+    auto config = lsltemplate::ConfigManager::load(filename.toStdString(), &error);
 
     if (config) {
-        ui_->input_name->setText(QString::fromStdString(config->stream_name));
-        ui_->input_type->setText(QString::fromStdString(config->stream_type));
-        ui_->input_channels->setValue(config->channel_count);
-        ui_->input_srate->setValue(config->sample_rate);
-        ui_->input_device->setValue(config->device_param);
+        applyConfig(*config);
         last_config_path_ = filename;
+        watchConfig(filename);
         updateStatus("Loaded: " + filename, false);
     } else {
         QMessageBox::warning(
             this,
             "Load Failed",
-            QString("Failed to load configuration from:\n%1").arg(filename)
+            QString("Failed to load configuration from:\n%1\n%2")
+                .arg(filename, QString::fromStdString(error))
         );
     }
 }
 
-void MainWindow::saveConfig(const QString& filename) {
-    lsltemplate::AppConfig config{
-        .stream_name = ui_->input_name->text().toStdString(),
-        .stream_type = ui_->input_type->text().toStdString(),
-        .channel_count = ui_->input_channels->value(),
-        .sample_rate = ui_->input_srate->value(),
-        .device_param = ui_->input_device->value()
-    };
+void MainWindow::applyConfig(const lsltemplate::AppConfig& config) {
+    ui_->input_name->setText(QString::fromStdString(config.stream_name));
+    ui_->input_type->setText(QString::fromStdString(config.stream_type));
+    ui_->input_channels->setValue(config.channel_count);
+    ui_->input_srate->setValue(config.sample_rate);
+    ui_->input_format->setCurrentText(lsltemplate::toString(config.sample_format));
+    ui_->input_device->setValue(config.device_param);
+    config_ = config;
+}
 
-    if (lsltemplate::ConfigManager::save(config, filename.toStdString())) {
+void MainWindow::saveConfig(const QString& filename) {
+    if (lsltemplate::ConfigManager::save(currentConfig(), filename.toStdString())) {
         last_config_path_ = filename;
+        watchConfig(filename);
         updateStatus("Saved: " + filename, false);
     } else {
         QMessageBox::warning(
@@ -185,6 +433,29 @@ void MainWindow::saveConfig(const QString& filename) {
     }
 }
 
+void MainWindow::watchConfig(const QString& filename) {
+    const std::filesystem::path path = std::filesystem::absolute(filename.toStdString());
+    if (watcher_ && watcher_->path() == path) {
+        return;
+    }
+    // The watcher thread only posts to the GUI thread, which does the reloading
+    watcher_ = std::make_unique<lsltemplate::ConfigWatcher>(path, [this]() {
+        QMetaObject::invokeMethod(this, &MainWindow::onConfigFileChanged);
+    });
+    watcher_->start();
+}
+
+lsltemplate::AppConfig MainWindow::currentConfig() const {
+    lsltemplate::AppConfig config = config_;
+    config.stream_name = ui_->input_name->text().toStdString();
+    config.stream_type = ui_->input_type->text().toStdString();
+    config.channel_count = ui_->input_channels->value();
+    config.sample_rate = ui_->input_srate->value();
+    config.sample_format = selectedFormat();
+    config.device_param = ui_->input_device->value();
+    return config;
+}
+
 QString MainWindow::findDefaultConfigFile() {
     QFileInfo exe_info(QCoreApplication::applicationFilePath());
     QString default_name = exe_info.completeBaseName() + ".cfg";
@@ -205,6 +476,11 @@ QString MainWindow::findDefaultConfigFile() {
     return QString();
 }
 
+lsltemplate::SampleFormat MainWindow::selectedFormat() const {
+    auto format = lsltemplate::parseSampleFormat(ui_->input_format->currentText().toStdString());
+    return format.value_or(lsltemplate::SampleFormat::Float32);
+}
+
 void MainWindow::updateStatus(const QString& message, bool is_error) {
     ui_->statusbar->showMessage(message, is_error ? 0 : 5000);
 
@@ -215,13 +491,43 @@ void MainWindow::updateStatus(const QString& message, bool is_error) {
     }
 }
 
-void MainWindow::setStreaming(bool streaming) {
-    ui_->linkButton->setText(streaming ? "Unlink" : "Link");
+void MainWindow::setState(LinkState state) {
+    state_ = state;
+    switch (state) {
+        case LinkState::Unlinked:
+            ui_->linkButton->setText("Link");
+            break;
+        case LinkState::Linking:
+            ui_->linkButton->setText(QStringLiteral("Linking\u2026"));
+            break;
+        case LinkState::Linked:
+            ui_->linkButton->setText("Unlink");
+            break;
+        case LinkState::Unlinking:
+            ui_->linkButton->setText(QStringLiteral("Unlinking\u2026"));
+            break;
+    }
+    // No second click while the controller is busy
+    ui_->linkButton->setEnabled(state == LinkState::Unlinked || state == LinkState::Linked);
+
+    // The stream's buffers go away with it, so the plot lets go first
+    lsltemplate::StreamThread* stream = controller_->stream();
+    preview_->setSource(state == LinkState::Linked && stream ? stream->preview() : nullptr);
+
+    const bool streaming = state != LinkState::Unlinked;
+    if (state == LinkState::Linked) {
+        last_stats_ = {};
+        stats_timer_->start();
+    } else {
+        stats_timer_->stop();
+        stats_label_->clear();
+    }
 
     // Disable config inputs while streaming
     ui_->input_name->setEnabled(!streaming);
     ui_->input_type->setEnabled(!streaming);
     ui_->input_channels->setEnabled(!streaming);
     ui_->input_srate->setEnabled(!streaming);
+    ui_->input_format->setEnabled(!streaming);
     ui_->input_device->setEnabled(!streaming);
 }
@@ -4,15 +4,25 @@
  * @brief Main window for LSL Template GUI application
  */
 
+#include <lsltemplate/Config.hpp>
+#include <lsltemplate/StreamStats.hpp>
+#include <lsltemplate/StreamThread.hpp>
+
+#include "StreamController.hpp"
+
 #include <QMainWindow>
 #include <memory>
 
+class PreviewWidget;
+class QLabel;
+class QTimer;
+
 namespace Ui {
 class MainWindow;
 }
 
 namespace lsltemplate {
-class StreamThread;
+class ConfigWatcher;
 }
 
 class MainWindow : public QMainWindow {
@@ -30,15 +40,42 @@ private slots:
     void onLoadConfig();
     void onSaveConfig();
     void onAbout();
+    void onStatsTimer();
+    void onConfigFileChanged();
+    void onStreamStarted(bool ok);
+    void onStreamStopped();
 
 private:
+    enum class LinkState { Unlinked, Linking, Linked, Unlinking };
+
+    void startStreaming();
+    void stopStreaming();
     void loadConfig(const QString& filename);
+    void applyConfig(const lsltemplate::AppConfig& config);
     void saveConfig(const QString& filename);
+    void watchConfig(const QString& filename);
+    lsltemplate::AppConfig currentConfig() const;
+    lsltemplate::StreamThread::Config streamConfig(const lsltemplate::AppConfig& config);
     QString findDefaultConfigFile();
+    lsltemplate::SampleFormat selectedFormat() const;
     void updateStatus(const QString& message, bool is_error);
-    void setStreaming(bool streaming);
+    void setState(LinkState state);
 
     std::unique_ptr<Ui::MainWindow> ui_;
-    std::unique_ptr<lsltemplate::StreamThread> stream_;
+    std::unique_ptr<StreamController> controller_;  // Starts and stops the stream
+    LinkState state_ = LinkState::Unlinked;
+    bool close_pending_ = false;    // Close once unlinked
+    bool restart_pending_ = false;  // Link again once unlinked
+    bool reload_pending_ = false;   // Config file changed while in transition
+    lsltemplate::AppConfig config_;  // Settings without a UI field are kept here
+    lsltemplate::AppConfig streamed_config_;  // What the stream was started with or updated to
     QString last_config_path_;
+    std::unique_ptr<lsltemplate::ConfigWatcher> watcher_;  // On last_config_path_
+
+    PreviewWidget* preview_ = nullptr;  // Live plot of the stream
+
+    // Live rate readout in the status bar
+    QLabel* stats_label_ = nullptr;
+    QTimer* stats_timer_ = nullptr;
+    lsltemplate::StreamStats last_stats_;
 };
@@ -0,0 +1,134 @@
+/**
+ * @file PreviewWidget.cpp
+ * @brief Envelope rendering for the live plot
+ */
+
+#include "PreviewWidget.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include <QPainter>
+#include <QTimer>
+
+namespace {
+
+constexpr int kFrameInterval = 16;  // ms, about 60 fps
+constexpr int kMinBandHeight = 4;   // Pixels per channel
+
+} // anonymous namespace
+
+PreviewWidget::PreviewWidget(QWidget* parent)
+    : QWidget(parent)
+{
+    setMinimumHeight(80);
+    setAttribute(Qt::WA_OpaquePaintEvent);
+
+    timer_ = new QTimer(this);
+    timer_->setInterval(kFrameInterval);
+    connect(timer_, &QTimer::timeout, this, &PreviewWidget::onFrameTimer);
+}
+
+void PreviewWidget::setSource(lsltemplate::PreviewBuffer* source) {
+    if (source == source_) {
+        return;
+    }
+    source_ = source;
+    frame_ = nullptr;
+    image_ = QImage();  // Cleared on the next paint
+    if (source_) {
+        timer_->start();
+    } else {
+        timer_->stop();
+    }
+    update();
+}
+
+void PreviewWidget::onFrameTimer() {
+    const lsltemplate::PreviewFrame* frame = source_->latest();
+    if (frame && frame->sequence != sequence_) {
+        frame_ = frame;
+        update();
+    }
+}
+
+void PreviewWidget::paintEvent(QPaintEvent* /*event*/) {
+    if (image_.size() != size() || (frame_ && frame_->sequence != sequence_)) {
+        render();
+    }
+    QPainter painter(this);
+    painter.drawImage(0, 0, image_);
+}
+
+void PreviewWidget::render() {
+    if (image_.size() != size()) {
+        image_ = QImage(size(), QImage::Format_RGB32);
+    }
+    image_.fill(palette().color(QPalette::Base));
+    sequence_ = frame_ ? frame_->sequence : 0;
+    if (!frame_ || frame_->columns == 0 || width() <= 0 || height() <= 0) {
+        return;
+    }
+
+    const lsltemplate::PreviewFrame& frame = *frame_;
+    const int width = image_.width();
+    const int height = image_.height();
+    const std::size_t shown = std::min<std::size_t>(
+        frame.channels, static_cast<std::size_t>(std::max(1, height / kMinBandHeight)));
+    const double band = static_cast<double>(height) / static_cast<double>(shown);
+    const QRgb trace = palette().color(QPalette::Text).rgb();
+    uchar* const bits = image_.bits();
+    const qsizetype stride = image_.bytesPerLine();
+
+    for (std::size_t ch = 0; ch < shown; ++ch) {
+        // Scale each band to its channel's range over the whole window
+        float low = frame.minAt(ch, 0);
+        float high = frame.maxAt(ch, 0);
+        for (std::size_t c = 1; c < frame.columns; ++c) {
+            low = std::min(low, frame.minAt(ch, c));
+            high = std::max(high, frame.maxAt(ch, c));
+        }
+        if (!std::isfinite(low) || !std::isfinite(high)) {
+            continue;
+        }
+        // A flat channel is drawn through the middle of its band
+        const double span = std::max(0.0, band - 2.0);
+        const double range = high > low ? static_cast<double>(high - low) : 1.0;
+        const double top = static_cast<double>(ch) * band + 1.0 + (high > low ? 0.0 : span / 2.0);
+        const double scale = span / range;
+        const auto toY = [&](float value) {
+            const double y = top + (static_cast<double>(high) - static_cast<double>(value)) * scale;
+            return std::clamp(static_cast<int>(y), 0, height - 1);
+        };
+
+        // Columns map onto the full width, so the trace grows from the left
+        // until the window is filled and then scrolls
+        for (int x = 0; x < width; ++x) {
+            const std::size_t first = static_cast<std::size_t>(x) * frame.capacity / static_cast<std::size_t>(width);
+            if (first >= frame.columns) {
+                break;
+            }
+            const std::size_t last = std::min(
+                frame.columns,
+                std::max(first + 1, static_cast<std::size_t>(x + 1) * frame.capacity / static_cast<std::size_t>(width)));
+            float column_low = frame.minAt(ch, first);
+            float column_high = frame.maxAt(ch, first);
+            for (std::size_t c = first + 1; c < last; ++c) {
+                column_low = std::min(column_low, frame.minAt(ch, c));
+                column_high = std::max(column_high, frame.maxAt(ch, c));
+            }
+            const int y_top = toY(column_high);
+            const int y_bottom = toY(column_low);
+            for (int y = y_top; y <= y_bottom; ++y) {
+                reinterpret_cast<QRgb*>(bits + y * stride)[x] = trace;
+            }
+        }
+    }
+
+    if (shown < frame.channels) {
+        QPainter painter(&image_);
+        painter.setPen(palette().color(QPalette::PlaceholderText));
+        painter.drawText(image_.rect().adjusted(0, 0, -4, -2), Qt::AlignRight | Qt::AlignBottom,
+                         QString("%1 of %2 channels").arg(shown).arg(frame.channels));
+    }
+}
@@ -0,0 +1,46 @@
+#pragma once
+/**
+ * @file PreviewWidget.hpp
+ * @brief Live min/max plot of the streamed signal
+ */
+
+#include <lsltemplate/PreviewBuffer.hpp>
+
+#include <QImage>
+#include <QWidget>
+#include <cstdint>
+
+class QTimer;
+
+/**
+ * @brief Draws the envelope of a PreviewBuffer, one band per channel
+ *
+ * Polls the buffer at display rate and repaints only when a new frame was
+ * published. Envelope columns are reduced to the widget width (min of mins,
+ * max of maxes per pixel), and each band is scaled to its channel's range.
+ * Channels that would get bands thinner than a few pixels are left out.
+ */
+class PreviewWidget : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit PreviewWidget(QWidget* parent = nullptr);
+
+    /// Buffer to draw, or nullptr to clear; it must outlive the next call
+    void setSource(lsltemplate::PreviewBuffer* source);
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+
+private slots:
+    void onFrameTimer();
+
+private:
+    void render();
+
+    lsltemplate::PreviewBuffer* source_ = nullptr;
+    const lsltemplate::PreviewFrame* frame_ = nullptr;  // Owned by source_
+    uint64_t sequence_ = 0;  // Of the frame in image_
+    QTimer* timer_ = nullptr;
+    QImage image_;
+};
@@ -0,0 +1,53 @@
+/**
+ * @file StreamController.cpp
+ * @brief Background start and stop of the stream
+ */
+
+#include "StreamController.hpp"
+
+StreamController::StreamController(QObject* parent)
+    : QObject(parent)
+    , worker_(std::make_unique<QObject>())
+{
+    thread_.setObjectName("StreamController");
+    worker_->moveToThread(&thread_);
+    thread_.start();
+}
+
+StreamController::~StreamController() {
+    stream_ = nullptr;
+    // Runs after everything queued before it
+    post([this]() {
+        owned_.reset();
+        thread_.quit();
+    });
+    thread_.wait();
+}
+
+void StreamController::start(std::unique_ptr<lsltemplate::StreamThread> stream) {
+    lsltemplate::StreamThread* raw = stream.release();
+    post([this, raw]() {
+        std::unique_ptr<lsltemplate::StreamThread> stream(raw);
+        const bool ok = stream->start();
+        if (ok) {
+            owned_ = std::move(stream);
+        }
+        // A stream that failed to start is destroyed here, off the GUI thread
+        QMetaObject::invokeMethod(this, [this, ok, raw]() {
+            stream_ = ok ? raw : nullptr;
+            emit started(ok);
+        });
+    });
+}
+
+void StreamController::stop() {
+    stream_ = nullptr;
+    post([this]() {
+        owned_.reset();  // Joins the streaming threads and disconnects
+        QMetaObject::invokeMethod(this, [this]() { emit stopped(); });
+    });
+}
+
+void StreamController::post(std::function<void()> job) {
+    QMetaObject::invokeMethod(worker_.get(), std::move(job), Qt::QueuedConnection);
+}
@@ -0,0 +1,57 @@
+#pragma once
+/**
+ * @file StreamController.hpp
+ * @brief Starts and stops the stream off the GUI thread
+ */
+
+#include <lsltemplate/StreamThread.hpp>
+
+#include <QObject>
+#include <QThread>
+#include <functional>
+#include <memory>
+
+/**
+ * @brief Runs StreamThread::start() and stop() on a thread of its own
+ *
+ * Connecting the device, creating the outlets, joining the streaming threads
+ * and disconnecting can take as long as the device SDK likes. The controller
+ * does all of it, in the order requested, on its own thread and reports back
+ * through started() and stopped(), so the window keeps repainting meanwhile.
+ *
+ * stream() is valid on the GUI thread from started(true) until stop() is
+ * called; in between the stream can be polled and updated as usual.
+ */
+class StreamController : public QObject {
+    Q_OBJECT
+
+public:
+    explicit StreamController(QObject* parent = nullptr);
+
+    /// Finishes the queued starts and stops, then stops a stream still running
+    ~StreamController() override;
+
+    StreamController(const StreamController&) = delete;
+    StreamController& operator=(const StreamController&) = delete;
+
+    /// Start the stream in the background; started() reports the outcome
+    void start(std::unique_ptr<lsltemplate::StreamThread> stream);
+
+    /// Stop and destroy the stream in the background; stopped() follows
+    void stop();
+
+    /// The started stream, or nullptr (see the class description)
+    lsltemplate::StreamThread* stream() const { return stream_; }
+
+signals:
+    void started(bool ok);
+    void stopped();
+
+private:
+    void post(std::function<void()> job);
+
+    QThread thread_;
+    std::unique_ptr<QObject> worker_;  // Lives on thread_; jobs run in its context
+    std::unique_ptr<lsltemplate::StreamThread> owned_;  // thread_ only
+    lsltemplate::StreamThread* stream_ = nullptr;       // GUI thread only
+};